@@ -78,6 +78,8 @@ CLASSHEADERS = \
     QwtText \
     QwtTextEngine \
     QwtTextLabel \
+    QwtTextMetricsCache \
+    QwtTextRasterCache \
     QwtTransform \
     QwtWidgetOverlay
 
@@ -97,8 +99,10 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlot \
         QwtPlotAbstractBarChart \
         QwtPlotBarChart \
+        QwtPlotBatchRenderer \
         QwtPlotCanvas \
         QwtPlotCurve \
+        QwtPlotDescription \
         QwtPlotDict \
         QwtPlotDirectPainter \
         QwtPlotGrid \
@@ -109,6 +113,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotLegendItem \
         QwtPlotMagnifier \
         QwtPlotMarker \
+        QwtPlotMarkerCollection \
         QwtPlotMultiBarChart \
         QwtPlotPanner \
         QwtPlotPicker \
@@ -128,8 +133,10 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotZoomer \
         QwtScaleWidget \
         QwtRasterData \
+        QwtRenderScheduler \
         QwtSetSample \
         QwtSamplingThread \
+        QwtSpatialIndex \
         QwtSplineCurveFitter \
         QwtWeedingCurveFitter \
         QwtIntervalSeriesData \
@@ -139,7 +146,8 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtSyntheticPointData \
         QwtPointArrayData \
         QwtTradingChartData \
-        QwtCPointerData
+        QwtCPointerData \
+        QwtSharedPointerData
 }
 
 contains(QWT_CONFIG, QwtOpenGL) {
@@ -17,7 +17,8 @@ contains(QWT_CONFIG, QwtPlot) {
         shapes \
         curvetracker \
         vectorfield \
-        symbols
+        symbols \
+        polylines
 
     contains(QWT_CONFIG, QwtSvg) {
 
@@ -0,0 +1,388 @@
+/*****************************************************************************
+ * Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    Benchmark for the chunk sizes, that are used by QwtPainter::drawPolyline()
+    to split wide polylines for the different types of paint engines.
+
+    A wide polyline is painted with each chunk size to a QImage,
+    a PDF and a SVG document and - when available - an OpenGL framebuffer.
+    The times are measured with the profiling of QwtPainter and include
+    the time for finishing the device. For the vector formats the size of
+    the document is printed too.
+
+    The results can be used to adjust the defaults of
+    QwtPainter::setPolylineChunkSize(). Without display
+    run it with "-platform offscreen".
+ */
+
+#include <qwt_painter.h>
+
+#include <qapplication.h>
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qbuffer.h>
+#include <qelapsedtimer.h>
+#include <qlist.h>
+#include <qmath.h>
+
+#if QT_VERSION >= 0x050000
+#include <qpdfwriter.h>
+#endif
+
+#ifdef QT_SVG_LIB
+#include <qsvggenerator.h>
+#endif
+
+#if QT_VERSION >= 0x050100 && !defined( QWT_NO_OPENGL ) && !defined( QT_NO_OPENGL )
+#define POLYLINES_OPENGL
+#include <qoffscreensurface.h>
+#include <qopenglcontext.h>
+#include <qopenglfunctions.h>
+#include <qopenglframebufferobject.h>
+#include <qopenglpaintdevice.h>
+#endif
+
+#include <cstdio>
+
+static const int chunkSizes[] =
+    { 0, 2, 4, 6, 8, 12, 16, 32, 64, 128, 256, 512, 1024 };
+
+static const int numChunkSizes =
+    sizeof( chunkSizes ) / sizeof( chunkSizes[0] );
+
+static const int numPoints = 10000;
+static const int numPolylines = 10;
+static const int numRuns = 3;
+
+static const QSize deviceSize( 800, 600 );
+
+namespace
+{
+    class Result
+    {
+    public:
+        Result():
+            elapsed( 0 ),
+            documentSize( 0 )
+        {
+        }
+
+        QwtPainter::PolylineStatistics statistics;
+
+        qint64 elapsed;         // nanoseconds including QPainter::end()
+        qint64 documentSize;    // bytes
+    };
+
+    class Target
+    {
+    public:
+        virtual ~Target()
+        {
+        }
+
+        virtual const char *name() const = 0;
+        virtual Result run( int chunkSize, const QPolygonF & ) = 0;
+    };
+}
+
+static QPolygonF createPolyline()
+{
+    // a sine wave with a jagged overlay, what gives many sharp joins
+
+    const double w = deviceSize.width();
+    const double h = deviceSize.height();
+
+    QPolygonF polyline( numPoints );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const double x = i * w / ( numPoints - 1 );
+        const double y = 0.5 * h + 0.35 * h * qSin( x / 40.0 )
+            + 0.1 * h * qSin( i * 1.7 );
+
+        polyline[i] = QPointF( x, y );
+    }
+
+    return polyline;
+}
+
+static void paintPolylines( QPaintDevice *device,
+    int chunkSize, const QPolygonF &polyline, Result &result )
+{
+    QPainter painter( device );
+
+    const int engineType = painter.paintEngine()->type();
+
+    QwtPainter::setPolylineChunkSize( engineType, chunkSize );
+    QwtPainter::resetPolylineStatistics();
+
+    painter.setRenderHint( QPainter::Antialiasing, true );
+    painter.setPen( QPen( Qt::darkBlue, 3.0 ) );
+
+    for ( int i = 0; i < numPolylines; i++ )
+        QwtPainter::drawPolyline( &painter, polyline );
+
+    result.statistics = QwtPainter::polylineStatistics( engineType );
+
+    painter.end();
+}
+
+namespace
+{
+    class RasterTarget: public Target
+    {
+    public:
+        virtual const char *name() const QWT_OVERRIDE
+        {
+            return "Raster ( QImage )";
+        }
+
+        virtual Result run( int chunkSize,
+            const QPolygonF &polyline ) QWT_OVERRIDE
+        {
+            QImage image( deviceSize, QImage::Format_ARGB32_Premultiplied );
+            image.fill( 0xffffffff );
+
+            Result result;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            paintPolylines( &image, chunkSize, polyline, result );
+
+            result.elapsed = timer.nsecsElapsed();
+
+            return result;
+        }
+    };
+
+#if QT_VERSION >= 0x050000
+
+    class PdfTarget: public Target
+    {
+    public:
+        virtual const char *name() const QWT_OVERRIDE
+        {
+            return "PDF ( QPdfWriter )";
+        }
+
+        virtual Result run( int chunkSize,
+            const QPolygonF &polyline ) QWT_OVERRIDE
+        {
+            QBuffer buffer;
+            buffer.open( QIODevice::WriteOnly );
+
+            Result result;
+
+            {
+                QPdfWriter writer( &buffer );
+
+                QElapsedTimer timer;
+                timer.start();
+
+                paintPolylines( &writer, chunkSize, polyline, result );
+
+                result.elapsed = timer.nsecsElapsed();
+            }
+
+            result.documentSize = buffer.size();
+
+            return result;
+        }
+    };
+
+#endif
+
+#ifdef QT_SVG_LIB
+
+    class SvgTarget: public Target
+    {
+    public:
+        virtual const char *name() const QWT_OVERRIDE
+        {
+            return "SVG ( QSvgGenerator )";
+        }
+
+        virtual Result run( int chunkSize,
+            const QPolygonF &polyline ) QWT_OVERRIDE
+        {
+            QBuffer buffer;
+            buffer.open( QIODevice::WriteOnly );
+
+            Result result;
+
+            {
+                QSvgGenerator generator;
+                generator.setOutputDevice( &buffer );
+                generator.setSize( deviceSize );
+
+                QElapsedTimer timer;
+                timer.start();
+
+                paintPolylines( &generator, chunkSize, polyline, result );
+
+                result.elapsed = timer.nsecsElapsed();
+            }
+
+            result.documentSize = buffer.size();
+
+            return result;
+        }
+    };
+
+#endif
+
+#ifdef POLYLINES_OPENGL
+
+    class OpenGLTarget: public Target
+    {
+    public:
+        OpenGLTarget():
+            d_fbo( NULL )
+        {
+            d_surface.create();
+
+            if ( d_context.create() && d_context.makeCurrent( &d_surface ) )
+            {
+                QOpenGLFramebufferObjectFormat format;
+                format.setAttachment( QOpenGLFramebufferObject::CombinedDepthStencil );
+                format.setSamples( 4 );
+
+                d_fbo = new QOpenGLFramebufferObject( deviceSize, format );
+            }
+        }
+
+        virtual ~OpenGLTarget()
+        {
+            if ( d_fbo )
+            {
+                d_context.makeCurrent( &d_surface );
+                delete d_fbo;
+            }
+        }
+
+        bool isValid() const
+        {
+            return d_fbo && d_fbo->isValid();
+        }
+
+        virtual const char *name() const QWT_OVERRIDE
+        {
+            return "OpenGL ( QOpenGLPaintDevice )";
+        }
+
+        virtual Result run( int chunkSize,
+            const QPolygonF &polyline ) QWT_OVERRIDE
+        {
+            d_context.makeCurrent( &d_surface );
+            d_fbo->bind();
+
+            Result result;
+
+            QOpenGLPaintDevice device( deviceSize );
+
+            QElapsedTimer timer;
+            timer.start();
+
+            paintPolylines( &device, chunkSize, polyline, result );
+
+            // the commands are executed asynchronously
+            d_context.functions()->glFinish();
+
+            result.elapsed = timer.nsecsElapsed();
+
+            d_fbo->release();
+
+            return result;
+        }
+
+    private:
+        QOffscreenSurface d_surface;
+        QOpenGLContext d_context;
+        QOpenGLFramebufferObject *d_fbo;
+    };
+
+#endif
+}
+
+static void runBenchmark( Target *target, const QPolygonF &polyline )
+{
+    std::printf( "%s\n", target->name() );
+    std::printf( "%10s %12s %12s %10s %12s\n",
+        "chunk size", "total [ms]", "engine [ms]", "chunks", "size [kB]" );
+
+    int bestChunkSize = -1;
+    qint64 bestElapsed = 0;
+
+    for ( int i = 0; i < numChunkSizes; i++ )
+    {
+        const int chunkSize = chunkSizes[i];
+
+        // the fastest of several runs, to reduce the noise
+
+        Result result;
+        for ( int k = 0; k < numRuns; k++ )
+        {
+            const Result r = target->run( chunkSize, polyline );
+            if ( k == 0 || r.elapsed < result.elapsed )
+                result = r;
+        }
+
+        std::printf( "%10d %12.2f %12.2f %10lld %12lld\n", chunkSize,
+            result.elapsed / 1e6, result.statistics.elapsed / 1e6,
+            static_cast<long long>( result.statistics.chunkCount ),
+            static_cast<long long>( result.documentSize / 1024 ) );
+
+        if ( bestChunkSize < 0 || result.elapsed < bestElapsed )
+        {
+            bestChunkSize = chunkSize;
+            bestElapsed = result.elapsed;
+        }
+    }
+
+    std::printf( "fastest chunk size: %d ( 0: no splitting )\n\n", bestChunkSize );
+}
+
+int main( int argc, char *argv[] )
+{
+    QApplication app( argc, argv );
+
+    QwtPainter::setPolylineProfiling( true );
+
+    const QPolygonF polyline = createPolyline();
+
+    QList<Target *> targets;
+    targets += new RasterTarget();
+
+#if QT_VERSION >= 0x050000
+    targets += new PdfTarget();
+#endif
+
+#ifdef QT_SVG_LIB
+    targets += new SvgTarget();
+#endif
+
+#ifdef POLYLINES_OPENGL
+    OpenGLTarget *openGLTarget = new OpenGLTarget();
+    if ( openGLTarget->isValid() )
+    {
+        targets += openGLTarget;
+    }
+    else
+    {
+        std::printf( "OpenGL: no framebuffer available\n\n" );
+        delete openGLTarget;
+    }
+#endif
+
+    for ( int i = 0; i < targets.size(); i++ )
+        runBenchmark( targets[i], polyline );
+
+    qDeleteAll( targets );
+
+    return 0;
+}
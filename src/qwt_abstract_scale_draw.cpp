@@ -18,6 +18,7 @@
 #include <qmap.h>
 #include <qlist.h>
 #include <qlocale.h>
+#include <qmutex.h>
 
 class QwtAbstractScaleDraw::PrivateData
 {
@@ -47,6 +48,7 @@ public:
 
     double minExtent;
 
+    QMutex labelMutex;
     QMap<double, QwtText> labelCache;
 };
 
@@ -105,7 +107,8 @@ void QwtAbstractScaleDraw::setScaleDiv( const QwtScaleDiv &scaleDiv )
 {
     d_data->scaleDiv = scaleDiv;
     d_data->map.setScaleInterval( scaleDiv.lowerBound(), scaleDiv.upperBound() );
-    d_data->labelCache.clear();
+
+    invalidateCache();
 }
 
 /*!
@@ -382,11 +385,17 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
    \brief Convert a value into its representing label and cache it.
 
    The conversion between value and label is called very often
-   in the layout and painting code. Unfortunately the
-   calculation of the label sizes might be slow (really slow
-   for rich text in Qt4), so it's necessary to cache the labels.
+   in the layout and painting code, so the labels are cached.
+   Their sizes are not calculated here, but when they are needed,
+   using the caches of the text engines.
+
+   The cache is protected by a mutex, so that a scale draw can be rendered
+   from several threads at the same time. As the returned reference stays
+   valid until the cache is invalidated, label() needs to be thread safe
+   for this use case only.
 
-   \param font Font
+   \param font Ignored, as the sizes of the labels are not calculated here.
+               The parameter is kept for compatibility.
    \param value Value
 
    \return Tick label
@@ -394,17 +403,29 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
 const QwtText &QwtAbstractScaleDraw::tickLabel(
     const QFont &font, double value ) const
 {
-    QMap<double, QwtText>::const_iterator it1 = d_data->labelCache.constFind( value );
-    if ( it1 != d_data->labelCache.constEnd() )
-        return *it1;
+    Q_UNUSED( font )
+
+    {
+        QMutexLocker locker( &d_data->labelMutex );
+
+        QMap<double, QwtText>::const_iterator it1 =
+            d_data->labelCache.constFind( value );
+
+        if ( it1 != d_data->labelCache.constEnd() )
+            return *it1;
+    }
 
     QwtText lbl = label( value );
     lbl.setRenderFlags( 0 );
     lbl.setLayoutAttribute( QwtText::MinimumLayout );
 
-    ( void )lbl.textSize( font ); // initialize the internal cache
+    QMutexLocker locker( &d_data->labelMutex );
+
+    // another thread might have inserted the label in the meantime
+    QMap<double, QwtText>::iterator it2 = d_data->labelCache.find( value );
+    if ( it2 == d_data->labelCache.end() )
+        it2 = d_data->labelCache.insert( value, lbl );
 
-    QMap<double, QwtText>::iterator it2 = d_data->labelCache.insert( value, lbl );
     return *it2;
 }
 
@@ -417,5 +438,6 @@ const QwtText &QwtAbstractScaleDraw::tickLabel(
 */
 void QwtAbstractScaleDraw::invalidateCache()
 {
+    QMutexLocker locker( &d_data->labelMutex );
     d_data->labelCache.clear();
 }
@@ -121,100 +121,206 @@ private:
 
 using namespace QwtClip;
 
-template <class Polygon, class Rect, typename T>
-class QwtPolygonClipper
+template <class Polygon>
+class QwtClipSink
 {
     typedef typename Polygon::value_type Point;
+
 public:
-    explicit QwtPolygonClipper( const Rect &clipRect ):
-        d_clipRect( clipRect )
+    explicit inline QwtClipSink( Polygon &polygon ):
+        d_polygon( polygon )
     {
     }
 
-    void clipPolygon( Polygon &points1, bool closePolygon ) const
+    inline void add( const Point &point )
     {
-#if 0
-        if ( d_clipRect.contains( points1.boundingRect() ) )
-            return polygon;
-#endif
-
-        Polygon points2;
-        points2.reserve( qMin( 256, points1.size() ) );
+        d_polygon += point;
+    }
 
-        clipEdge< LeftEdge<Point, T> >( closePolygon, points1, points2 );
-        clipEdge< RightEdge<Point, T> >( closePolygon, points2, points1 );
-        clipEdge< TopEdge<Point, T> >( closePolygon, points1, points2 );
-        clipEdge< BottomEdge<Point, T> >( closePolygon, points2, points1 );
+    inline void flush()
+    {
     }
 
 private:
-    template <class Edge>
-    inline void clipEdge( bool closePolygon,
-        const Polygon &points, Polygon &clippedPoints ) const
+    Polygon &d_polygon;
+};
+
+/*
+    One edge of the Sutherland-Hodgman algorithm, that passes
+    its output point by point to the next stage. So the polygon
+    is clipped against all edges in a single pass without
+    intermediate buffers.
+
+    The closing edge of a polygon is processed in flush(), what
+    results in the same polygon as clipping edge by edge, only
+    with a rotated start point.
+ */
+template <class Point, class Edge, class Next>
+class QwtClipStage
+{
+public:
+    inline QwtClipStage( const Edge &edge, bool closePolygon, Next &next ):
+        d_edge( edge ),
+        d_closePolygon( closePolygon ),
+        d_count( 0 ),
+        d_next( next )
     {
-        clippedPoints.clear();
+    }
 
-        if ( points.size() < 2 )
+    inline void add( const Point &point )
+    {
+        if ( d_count == 0 )
         {
-            if ( points.size() == 1 )
-                clippedPoints += points[0];
+            d_first = point;
 
-            return;
+            if ( !d_closePolygon && d_edge.isInside( point ) )
+                d_next.add( point );
+        }
+        else
+        {
+            addEdge( point, d_prev );
         }
 
-        const Edge edge( d_clipRect.x(), d_clipRect.x() + d_clipRect.width(),
-            d_clipRect.y(), d_clipRect.y() + d_clipRect.height() );
+        d_prev = point;
+        d_count++;
+    }
 
-        if ( !closePolygon )
+    inline void flush()
+    {
+        if ( d_count == 1 )
         {
-            const Point &p1 = points.first();
+            // a single point is passed, even if it is outside
 
-            if ( edge.isInside( p1 ) )
-                clippedPoints += p1;
+            if ( d_closePolygon || !d_edge.isInside( d_first ) )
+                d_next.add( d_first );
         }
-        else
+        else if ( d_count > 1 && d_closePolygon )
         {
-            const Point &p1 = points.first();
-            const Point &p2 = points.last();
-
-            if ( edge.isInside( p1 ) )
-            {
-                if ( !edge.isInside( p2 ) )
-                    clippedPoints += edge.intersection( p1, p2 );
-
-                clippedPoints += p1;
-            }
-            else if ( edge.isInside( p2 ) )
-            {
-                clippedPoints += edge.intersection( p1, p2 );
-            }
+            addEdge( d_first, d_prev );
         }
 
-        const uint nPoints = points.size();
-        const Point* p = points.constData();
+        d_count = 0;
+        d_next.flush();
+    }
 
-        for ( uint i = 1; i < nPoints; i++ )
+private:
+    inline void addEdge( const Point &p1, const Point &p2 )
+    {
+        if ( d_edge.isInside( p1 ) )
         {
-            const Point &p1 = p[i];
-            const Point &p2 = p[i - 1];
-
-            if ( edge.isInside( p1 ) )
-            {
-                if ( !edge.isInside( p2 ) )
-                    clippedPoints += edge.intersection( p1, p2 );
-
-                clippedPoints += p1;
-            }
-            else if ( edge.isInside( p2 ) )
-            {
-                clippedPoints += edge.intersection( p1, p2 );
-            }
+            if ( !d_edge.isInside( p2 ) )
+                d_next.add( d_edge.intersection( p1, p2 ) );
+
+            d_next.add( p1 );
         }
+        else if ( d_edge.isInside( p2 ) )
+        {
+            d_next.add( d_edge.intersection( p1, p2 ) );
+        }
+    }
+
+    const Edge d_edge;
+    const bool d_closePolygon;
+
+    int d_count;
+    Point d_first;
+    Point d_prev;
+
+    Next &d_next;
+};
+
+template <class Polygon, class Rect, typename T>
+class QwtPolygonClipper
+{
+    typedef typename Polygon::value_type Point;
+
+    typedef QwtClipSink<Polygon> Sink;
+    typedef QwtClipStage< Point, BottomEdge<Point, T>, Sink > BottomStage;
+    typedef QwtClipStage< Point, TopEdge<Point, T>, BottomStage > TopStage;
+    typedef QwtClipStage< Point, RightEdge<Point, T>, TopStage > RightStage;
+    typedef QwtClipStage< Point, LeftEdge<Point, T>, RightStage > LeftStage;
+
+public:
+    QwtPolygonClipper( const Rect &clipRect,
+            Polygon &clipped, bool closePolygon ):
+        d_sink( clipped ),
+        d_bottomStage( edge< BottomEdge<Point, T> >( clipRect ), closePolygon, d_sink ),
+        d_topStage( edge< TopEdge<Point, T> >( clipRect ), closePolygon, d_bottomStage ),
+        d_rightStage( edge< RightEdge<Point, T> >( clipRect ), closePolygon, d_topStage ),
+        d_leftStage( edge< LeftEdge<Point, T> >( clipRect ), closePolygon, d_rightStage )
+    {
+    }
+
+    inline void addPoint( const Point &point )
+    {
+        d_leftStage.add( point );
     }
 
-    const Rect d_clipRect;
+    inline void addPoints( const Point *points, int numPoints )
+    {
+        for ( int i = 0; i < numPoints; i++ )
+            d_leftStage.add( points[i] );
+    }
+
+    inline void flush()
+    {
+        d_leftStage.flush();
+    }
+
+private:
+    template <class Edge>
+    static inline Edge edge( const Rect &clipRect )
+    {
+        return Edge( clipRect.x(), clipRect.x() + clipRect.width(),
+            clipRect.y(), clipRect.y() + clipRect.height() );
+    }
+
+    Sink d_sink;
+    BottomStage d_bottomStage;
+    TopStage d_topStage;
+    RightStage d_rightStage;
+    LeftStage d_leftStage;
 };
 
+template <class Polygon, class Rect, typename T>
+static inline void qwtClipPoints( const Rect &clipRect,
+    const typename Polygon::value_type *points, int numPoints,
+    Polygon &clipped, bool closePolygon )
+{
+    // keeping the memory of the buffer
+    clipped.resize( 0 );
+
+    QwtPolygonClipper<Polygon, Rect, T> clipper( clipRect, clipped, closePolygon );
+    clipper.addPoints( points, numPoints );
+    clipper.flush();
+}
+
+template <class Polygon, class Rect, typename T>
+static inline void qwtClipPolygon( const Rect &clipRect,
+    Polygon &polygon, bool closePolygon )
+{
+    if ( polygon.isEmpty() )
+        return;
+
+    Polygon clipped;
+    clipped.reserve( polygon.size() );
+
+    qwtClipPoints<Polygon, Rect, T>( clipRect,
+        polygon.constData(), polygon.size(), clipped, closePolygon );
+
+    polygon = clipped;
+}
+
+static inline QRect qwtIntClipRect( const QRectF &clipRect )
+{
+    const int minX = qCeil( clipRect.left() );
+    const int maxX = qFloor( clipRect.right() );
+    const int minY = qCeil( clipRect.top() );
+    const int maxY = qFloor( clipRect.bottom() );
+
+    return QRect( minX, minY, maxX - minX, maxY - minY );
+}
+
 class QwtCircleClipper
 {
 public:
@@ -367,15 +473,8 @@ QVector<QPointF> QwtCircleClipper::cuttingPoints(
 void QwtClipper::clipPolygon(
     const QRectF &clipRect, QPolygon &polygon, bool closePolygon )
 {
-    const int minX = qCeil( clipRect.left() );
-    const int maxX = qFloor( clipRect.right() );
-    const int minY = qCeil( clipRect.top() );
-    const int maxY = qFloor( clipRect.bottom() );
-
-    const QRect r( minX, minY, maxX - minX, maxY - minY );
-
-    QwtPolygonClipper<QPolygon, QRect, int> clipper( r );
-    clipper.clipPolygon( polygon, closePolygon );
+    qwtClipPolygon<QPolygon, QRect, int>(
+        qwtIntClipRect( clipRect ), polygon, closePolygon );
 }
 
 /*!
@@ -388,8 +487,7 @@ void QwtClipper::clipPolygon(
 void QwtClipper::clipPolygon(
     const QRect &clipRect, QPolygon &polygon, bool closePolygon )
 {
-    QwtPolygonClipper<QPolygon, QRect, int> clipper( clipRect );
-    clipper.clipPolygon( polygon, closePolygon );
+    qwtClipPolygon<QPolygon, QRect, int>( clipRect, polygon, closePolygon );
 }
 
 /*!
@@ -402,8 +500,50 @@ void QwtClipper::clipPolygon(
 void QwtClipper::clipPolygonF(
     const QRectF &clipRect, QPolygonF &polygon, bool closePolygon )
 {
-    QwtPolygonClipper<QPolygonF, QRectF, double> clipper( clipRect );
-    clipper.clipPolygon( polygon, closePolygon );
+    qwtClipPolygon<QPolygonF, QRectF, double>( clipRect, polygon, closePolygon );
+}
+
+/*!
+   Sutherland-Hodgman polygon clipping into a buffer
+
+   The polygon is clipped against all edges of the rectangle
+   in a single pass. The content of clipped is replaced, but
+   its memory is reused, so that no memory needs to be
+   allocated, when the same buffer is used for clipping many polygons.
+
+   \param clipRect Clip rectangle
+   \param points Points of the polygon
+   \param numPoints Number of points
+   \param clipped Buffer for the clipped polygon
+   \param closePolygon True, when the polygon is closed.
+                       Open polylines have no closing edge.
+*/
+void QwtClipper::clipPolygon( const QRectF &clipRect,
+    const QPoint *points, int numPoints,
+    QPolygon &clipped, bool closePolygon )
+{
+    qwtClipPoints<QPolygon, QRect, int>( qwtIntClipRect( clipRect ),
+        points, numPoints, clipped, closePolygon );
+}
+
+/*!
+   Sutherland-Hodgman polygon clipping into a buffer
+
+   \param clipRect Clip rectangle
+   \param points Points of the polygon
+   \param numPoints Number of points
+   \param clipped Buffer for the clipped polygon
+   \param closePolygon True, when the polygon is closed.
+                       Open polylines have no closing edge.
+
+   \sa clipPolygon()
+*/
+void QwtClipper::clipPolygonF( const QRectF &clipRect,
+    const QPointF *points, int numPoints,
+    QPolygonF &clipped, bool closePolygon )
+{
+    qwtClipPoints<QPolygonF, QRectF, double>( clipRect,
+        points, numPoints, clipped, closePolygon );
 }
 
 /*!
@@ -478,3 +618,69 @@ QVector<QwtInterval> QwtClipper::clipCircle( const QRectF &clipRect,
     QwtCircleClipper clipper( clipRect );
     return clipper.clipCircle( center, radius );
 }
+
+class QwtClipper::PolygonClipperF::PrivateData
+{
+public:
+    PrivateData( const QRectF &clipRect,
+            QPolygonF &clipped, bool closePolygon ):
+        clipper( clipRect, clipped, closePolygon )
+    {
+        clipped.resize( 0 );
+    }
+
+    QwtPolygonClipper<QPolygonF, QRectF, double> clipper;
+};
+
+/*!
+  \brief Constructor
+
+  \param clipRect Clip rectangle
+  \param clipped Buffer for the clipped polygon. Its content is
+                 replaced, but its memory is reused.
+  \param closePolygon True, when the polygon is closed.
+ */
+QwtClipper::PolygonClipperF::PolygonClipperF( const QRectF &clipRect,
+    QPolygonF &clipped, bool closePolygon )
+{
+    d_data = new PrivateData( clipRect, clipped, closePolygon );
+}
+
+//! Destructor
+QwtClipper::PolygonClipperF::~PolygonClipperF()
+{
+    delete d_data;
+}
+
+/*!
+  Pass the next point of the polygon to the clipper
+  \param point Point
+ */
+void QwtClipper::PolygonClipperF::addPoint( const QPointF &point )
+{
+    d_data->clipper.addPoint( point );
+}
+
+/*!
+  Pass the next points of the polygon to the clipper
+
+  \param points Points
+  \param numPoints Number of points
+ */
+void QwtClipper::PolygonClipperF::addPoints(
+    const QPointF *points, int numPoints )
+{
+    d_data->clipper.addPoints( points, numPoints );
+}
+
+/*!
+  Complete the clipped polygon
+
+  For closed polygons the closing edge is clipped. Points, that
+  are added after flush() start a new polygon, that is appended
+  to the buffer.
+ */
+void QwtClipper::PolygonClipperF::flush()
+{
+    d_data->clipper.flush();
+}
@@ -13,6 +13,7 @@
 #include "qwt_global.h"
 
 class QwtInterval;
+class QPoint;
 class QPointF;
 class QRect;
 class QRectF;
@@ -27,6 +28,34 @@ template <typename T> class QVector;
 class QWT_EXPORT QwtClipper
 {
 public:
+    /*!
+      \brief A clipper, that processes a polygon point by point
+
+      PolygonClipperF clips the points, as soon as they are added.
+      So clipping can be done in the same loop, where the points
+      are calculated ( f.e. mapped from plot coordinates ), without
+      storing the unclipped polygon.
+     */
+    class QWT_EXPORT PolygonClipperF
+    {
+    public:
+        PolygonClipperF( const QRectF &, QPolygonF &clipped,
+            bool closePolygon = false );
+
+        ~PolygonClipperF();
+
+        void addPoint( const QPointF & );
+        void addPoints( const QPointF *, int numPoints );
+
+        void flush();
+
+    private:
+        Q_DISABLE_COPY(PolygonClipperF)
+
+        class PrivateData;
+        PrivateData *d_data;
+    };
+
     static void clipPolygon( const QRect &,
         QPolygon &, bool closePolygon = false );
 
@@ -36,6 +65,14 @@ public:
     static void clipPolygonF( const QRectF &,
         QPolygonF &, bool closePolygon = false );
 
+    static void clipPolygon( const QRectF &,
+        const QPoint *, int numPoints,
+        QPolygon &clipped, bool closePolygon = false );
+
+    static void clipPolygonF( const QRectF &,
+        const QPointF *, int numPoints,
+        QPolygonF &clipped, bool closePolygon = false );
+
     static QPolygon clippedPolygon( const QRect &,
         const QPolygon &, bool closePolygon = false );
 
@@ -9,14 +9,31 @@
 
 #include "qwt_date_scale_draw.h"
 #include "qwt_text.h"
+#include "qwt_scale_div.h"
+#include "qwt_math.h"
+
+#include <qmutex.h>
+#include <qcache.h>
+#include <qpair.h>
+
+// key of a formatted label: ( msecs, interval type )
+typedef QPair<qint64, int> QwtDateLabelKey;
 
 class QwtDateScaleDraw::PrivateData
 {
 public:
+    enum
+    {
+        MaxLabels = 1000
+    };
+
     explicit PrivateData( Qt::TimeSpec spec ):
         timeSpec( spec ),
         utcOffset( 0 ),
-        week0Type( QwtDate::FirstThursday )
+        week0Type( QwtDate::FirstThursday ),
+        hasIntervalType( false ),
+        intervalType( QwtDate::Second ),
+        labelCache( MaxLabels )
     {
         dateFormats[ QwtDate::Millisecond ] = "hh:mm:ss:zzz\nddd dd MMM yyyy";
         dateFormats[ QwtDate::Second ] = "hh:mm:ss\nddd dd MMM yyyy";
@@ -32,6 +49,24 @@ public:
     int utcOffset;
     QwtDate::Week0Type week0Type;
     QString dateFormats[ QwtDate::Year + 1 ];
+
+    void clearCache()
+    {
+        QMutexLocker locker( &mutex );
+
+        hasIntervalType = false;
+        labelCache.clear();
+    }
+
+    QMutex mutex;
+
+    // interval type of the most recent scale division
+    bool hasIntervalType;
+    QwtScaleDiv intervalScaleDiv;
+    QwtDate::IntervalType intervalType;
+
+    // formatted labels, that survive changes of the scale division
+    QCache<QwtDateLabelKey, QString> labelCache;
 };
 
 /*!
@@ -65,6 +100,7 @@ QwtDateScaleDraw::~QwtDateScaleDraw()
 void QwtDateScaleDraw::setTimeSpec( Qt::TimeSpec timeSpec )
 {
     d_data->timeSpec = timeSpec;
+    d_data->clearCache();
 }
 
 /*!
@@ -89,6 +125,7 @@ Qt::TimeSpec QwtDateScaleDraw::timeSpec() const
 void QwtDateScaleDraw::setUtcOffset( int seconds )
 {
     d_data->utcOffset = seconds;
+    d_data->clearCache();
 }
 
 /*!
@@ -115,6 +152,7 @@ int QwtDateScaleDraw::utcOffset() const
 void QwtDateScaleDraw::setWeek0Type( QwtDate::Week0Type week0Type )
 {
     d_data->week0Type = week0Type;
+    d_data->clearCache();
 }
 
 /*!
@@ -141,6 +179,7 @@ void QwtDateScaleDraw::setDateFormat(
         intervalType <= QwtDate::Year )
     {
         d_data->dateFormats[ intervalType ] = format;
+        d_data->clearCache();
     }
 }
 
@@ -197,6 +236,13 @@ QString QwtDateScaleDraw::dateFormatOfDate( const QDateTime &dateTime,
   The value is converted to a datetime value using toDateTime()
   and converted to a plain text using QwtDate::toString().
 
+  Formatted labels are cached by their value in milliseconds and
+  the interval type of the scale division. In opposite to the label cache
+  of QwtAbstractScaleDraw this cache survives changes of the scale
+  division, so that scrolling a time axis does not need to convert and
+  format the same values again. The cache is cleared, whenever
+  one of the format or time specification parameters is modified.
+
   \param value Value
   \return Label string.
 
@@ -204,11 +250,55 @@ QString QwtDateScaleDraw::dateFormatOfDate( const QDateTime &dateTime,
 */
 QwtText QwtDateScaleDraw::label( double value ) const
 {
+    QwtDate::IntervalType intvType = QwtDate::Second;
+    bool hasIntervalType = false;
+
+    {
+        QMutexLocker locker( &d_data->mutex );
+
+        if ( d_data->hasIntervalType
+            && d_data->intervalScaleDiv == scaleDiv() )
+        {
+            intvType = d_data->intervalType;
+            hasIntervalType = true;
+        }
+    }
+
+    if ( !hasIntervalType )
+    {
+        // intervalType() iterates over all major ticks
+
+        intvType = intervalType( scaleDiv() );
+
+        QMutexLocker locker( &d_data->mutex );
+
+        d_data->intervalScaleDiv = scaleDiv();
+        d_data->intervalType = intvType;
+        d_data->hasIntervalType = true;
+    }
+
+    // QwtDate::toDateTime() has a resolution of milliseconds
+
+    const QwtDateLabelKey key(
+        static_cast<qint64>( std::floor( value ) ), intvType );
+
+    {
+        QMutexLocker locker( &d_data->mutex );
+
+        const QString *text = d_data->labelCache.object( key );
+        if ( text )
+            return *text;
+    }
+
     const QDateTime dt = toDateTime( value );
-    const QString fmt = dateFormatOfDate(
-        dt, intervalType( scaleDiv() ) );
+    const QString fmt = dateFormatOfDate( dt, intvType );
+
+    const QString text = QwtDate::toString( dt, fmt, d_data->week0Type );
+
+    QMutexLocker locker( &d_data->mutex );
+    d_data->labelCache.insert( key, new QString( text ) );
 
-    return QwtDate::toString( dt, fmt, d_data->week0Type );
+    return text;
 }
 
 /*!
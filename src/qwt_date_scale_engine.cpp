@@ -12,6 +12,7 @@
 #include "qwt_interval.h"
 
 #include <qdatetime.h>
+#include <qvector.h>
 
 #include <limits>
 
@@ -450,6 +451,74 @@ static QList<double> qwtDstTicks( const QDateTime &dateTime,
     return ticks;
 }
 
+static QwtScaleDiv qwtDivideToMSecs( double minValue, double maxValue,
+    qint64 msecsMajor, double msecsMinor )
+{
+    // Without daylight saving time seconds, minutes, hours, days
+    // and weeks are equidistant in msecs since epoch. So we can
+    // calculate the ticks without converting each of them
+    // into a QDateTime.
+
+    int numMinorSteps = 0;
+    if ( msecsMinor > 0.0 )
+        numMinorSteps = qwtFloor( msecsMajor / msecsMinor );
+
+    const int numMajorTicks =
+        qwtFloor( ( maxValue - minValue ) / msecsMajor ) + 1;
+
+    QVector<qint64> minorOffsets;
+    if ( numMinorSteps > 1 )
+    {
+        minorOffsets.resize( numMinorSteps );
+        for ( int i = 1; i < numMinorSteps; i++ )
+            minorOffsets[i] = qRound64( i * msecsMinor );
+    }
+
+    const int mediumIndex = ( numMinorSteps % 2 == 0 && numMinorSteps > 2 )
+        ? numMinorSteps / 2 : -1;
+
+    QList<double> majorTicks;
+    QList<double> mediumTicks;
+    QList<double> minorTicks;
+
+#if QT_VERSION >= 0x040700
+    majorTicks.reserve( numMajorTicks );
+    if ( numMinorSteps > 1 )
+        minorTicks.reserve( numMajorTicks * ( numMinorSteps - 1 ) );
+    if ( mediumIndex > 0 )
+        mediumTicks.reserve( numMajorTicks );
+#endif
+
+    for ( int k = 0; k < numMajorTicks; k++ )
+    {
+        const double majorValue = minValue + double( k ) * msecsMajor;
+        if ( majorValue > maxValue )
+            break;
+
+        majorTicks += majorValue;
+
+        for ( int i = 1; i < numMinorSteps; i++ )
+        {
+            const double minorValue = majorValue + minorOffsets[i];
+
+            if ( i == mediumIndex )
+                mediumTicks += minorValue;
+            else
+                minorTicks += minorValue;
+        }
+    }
+
+    QwtScaleDiv scaleDiv;
+
+    scaleDiv.setInterval( minValue, maxValue );
+
+    scaleDiv.setTicks( QwtScaleDiv::MajorTick, majorTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MediumTick, mediumTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MinorTick, minorTicks );
+
+    return scaleDiv;
+}
+
 static QwtScaleDiv qwtDivideToSeconds(
     const QDateTime &minDate, const QDateTime &maxDate,
     double stepSize, int maxMinSteps,
@@ -478,6 +547,18 @@ static QwtScaleDiv qwtDivideToSeconds(
     const int secondsMajor = static_cast<int>( stepSize * s );
     const double secondsMinor = minStepSize * s;
 
+    const Qt::TimeSpec timeSpec = minDate.timeSpec();
+
+    if ( ( timeSpec == Qt::UTC || timeSpec == Qt::OffsetFromUTC )
+        && secondsMajor > 0 )
+    {
+        // no daylight saving transitions: the ticks are fixed steps
+
+        return qwtDivideToMSecs(
+            QwtDate::toDouble( minDate ), QwtDate::toDouble( maxDate ),
+            Q_INT64_C( 1000 ) * secondsMajor, 1000.0 * secondsMinor );
+    }
+
     // UTC excludes daylight savings. So from the difference
     // of a date and its UTC counterpart we can find out
     // the daylight saving hours
@@ -9,6 +9,7 @@
 
 #include "qwt_graphic.h"
 #include "qwt_painter_command.h"
+#include "qwt_painter.h"
 #include "qwt_math.h"
 
 #include <qvector.h>
@@ -17,6 +18,9 @@
 #include <qimage.h>
 #include <qpixmap.h>
 #include <qpainterpath.h>
+#include <qsharedpointer.h>
+#include <qmutex.h>
+#include <qlist.h>
 
 static bool qwtHasScalablePen( const QPainter *painter )
 {
@@ -64,6 +68,41 @@ static QRectF qwtStrokedPathRect(
     return rect;
 }
 
+static bool qwtCanCull( const QPainter *painter )
+{
+    /*
+        Only for pixel devices the geometry of the device starts
+        at the origin. The metrics of a QPicture or a QwtGraphic
+        are the bounding rectangle of what has been painted so far,
+        that might have negative or offset coordinates.
+     */
+
+    const QPaintDevice *device = painter->device();
+    if ( device == NULL )
+        return false;
+
+    switch( device->devType() )
+    {
+        case QInternal::Image:
+        case QInternal::Pixmap:
+        case QInternal::Widget:
+            return true;
+
+        default:
+            break;
+    }
+
+    const QPaintEngine *engine = painter->paintEngine();
+    if ( engine == NULL )
+        return false;
+
+    const QPaintEngine::Type type = engine->type();
+    if ( type == QPaintEngine::Picture || type >= QPaintEngine::User )
+        return false;
+
+    return QwtPainter::roundingAlignment( painter );
+}
+
 static inline void qwtExecCommand(
     QPainter *painter, const QwtPainterCommand &cmd,
     QwtGraphic::RenderHints renderHints,
@@ -309,19 +348,137 @@ public:
         return sy;
     }
 
+    inline QRectF pointRect() const
+    {
+        return d_pointRect;
+    }
+
+    inline QRectF boundingRect() const
+    {
+        return d_boundingRect;
+    }
+
 private:
     QRectF d_pointRect;
     QRectF d_boundingRect;
     bool d_scalablePen;
 };
 
+static inline bool qwtCanMergeStates(
+    const QwtPainterCommand::StateData *state1,
+    const QwtPainterCommand::StateData *state2 )
+{
+    const QPaintEngine::DirtyFlags clipFlags = QPaintEngine::DirtyClipEnabled
+        | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath;
+
+    if ( state1->flags & clipFlags )
+    {
+        /*
+            Clip operations depend on the order and on the
+            transformation, that has been set before
+         */
+        if ( state2->flags & ( clipFlags | QPaintEngine::DirtyTransform ) )
+            return false;
+    }
+
+    return true;
+}
+
+static void qwtMergeStates( QwtPainterCommand::StateData *state,
+    const QwtPainterCommand::StateData *next )
+{
+    const QPaintEngine::DirtyFlags flags = next->flags;
+
+    if ( flags & QPaintEngine::DirtyPen )
+        state->pen = next->pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        state->brush = next->brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        state->brushOrigin = next->brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        state->font = next->font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        state->backgroundMode = next->backgroundMode;
+        state->backgroundBrush = next->backgroundBrush;
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        state->transform = next->transform;
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        state->isClipEnabled = next->isClipEnabled;
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+    {
+        state->clipRegion = next->clipRegion;
+        state->clipOperation = next->clipOperation;
+    }
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+    {
+        state->clipPath = next->clipPath;
+        state->clipOperation = next->clipOperation;
+    }
+
+    if ( flags & QPaintEngine::DirtyHints )
+        state->renderHints = next->renderHints;
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        state->compositionMode = next->compositionMode;
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        state->opacity = next->opacity;
+
+    state->flags |= flags;
+}
+
+static inline bool qwtIntersects( const QRectF &rect1, const QRectF &rect2 )
+{
+    // QRectF::intersects fails for rectangles without width or height
+    return ( rect1.left() <= rect2.right() ) && ( rect1.right() >= rect2.left() )
+        && ( rect1.top() <= rect2.bottom() ) && ( rect1.bottom() >= rect2.top() );
+}
+
+namespace
+{
+    class QwtGraphicRaster
+    {
+    public:
+        QSizeF size;
+        int aspectRatioMode;
+        bool antialiased;
+        qreal pixelRatio;
+
+        QImage image;
+    };
+}
+
+class QwtGraphic::CompiledData
+{
+public:
+    QVector<QwtPainterCommand> commands;
+
+    // control point and bounding rectangles of the paths for culling
+    QVector<QRectF> pointRects;
+    QVector<QRectF> boundingRects;
+
+    QMutex mutex;
+    QList<QwtGraphicRaster> rasters;
+};
+
 class QwtGraphic::PrivateData
 {
 public:
     PrivateData():
         boundingRect( 0.0, 0.0, -1.0, -1.0 ),
         pointRect( 0.0, 0.0, -1.0, -1.0 ),
-        initialTransform( NULL )
+        initialTransform( NULL ),
+        rasterCacheSize( 0 )
     {
     }
 
@@ -334,6 +491,9 @@ public:
 
     QwtGraphic::RenderHints renderHints;
     QTransform *initialTransform;
+
+    int rasterCacheSize;
+    QSharedPointer<QwtGraphic::CompiledData> compiled;
 };
 
 /*!
@@ -395,6 +555,7 @@ void QwtGraphic::reset()
     d_data->pointRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     d_data->defaultSize = QSizeF();
 
+    d_data->compiled.clear();
 }
 
 /*!
@@ -429,6 +590,12 @@ void QwtGraphic::setRenderHint( RenderHint hint, bool on )
         d_data->renderHints |= hint;
     else
         d_data->renderHints &= ~hint;
+
+    if ( d_data->compiled )
+    {
+        QMutexLocker locker( &d_data->compiled->mutex );
+        d_data->compiled->rasters.clear();
+    }
 }
 
 /*!
@@ -566,15 +733,80 @@ void QwtGraphic::render( QPainter *painter ) const
     if ( isNull() )
         return;
 
-    const int numCommands = d_data->commands.size();
-    const QwtPainterCommand *commands = d_data->commands.constData();
-
     const QTransform transform = painter->transform();
 
+    const CompiledData *compiled = d_data->compiled.data();
+    if ( compiled == NULL )
+    {
+        const int numCommands = d_data->commands.size();
+        const QwtPainterCommand *commands = d_data->commands.constData();
+
+        painter->save();
+
+        for ( int i = 0; i < numCommands; i++ )
+        {
+            qwtExecCommand( painter, commands[i],
+                d_data->renderHints, transform, d_data->initialTransform );
+        }
+
+        painter->restore();
+
+        return;
+    }
+
+    // the visible area in graphic coordinates
+
+    QRectF visibleRect;
+    double margin = 1.0;
+
+    const QPaintDevice *device = painter->device();
+    if ( qwtCanCull( painter ) && device->width() > 0
+        && device->height() > 0 && transform.isInvertible() )
+    {
+        visibleRect = transform.inverted().mapRect(
+            QRectF( 0.0, 0.0, device->width(), device->height() ) );
+
+#if QT_VERSION >= 0x040800
+        if ( painter->hasClipping() )
+            visibleRect &= painter->clipBoundingRect();
+#endif
+
+        // unscaled pens are wider in graphic coordinates, when scaling down
+
+        const double sx = qSqrt( qwtSqr( transform.m11() ) + qwtSqr( transform.m12() ) );
+        const double sy = qSqrt( qwtSqr( transform.m21() ) + qwtSqr( transform.m22() ) );
+
+        const double s = qwtMinF( sx, sy );
+        if ( s > 0.0 && s < 1.0 )
+            margin = 1.0 / s;
+    }
+
+    const bool doCull = !visibleRect.isEmpty();
+
+    const int numCommands = compiled->commands.size();
+    const QwtPainterCommand *commands = compiled->commands.constData();
+    const QRectF *pointRects = compiled->pointRects.constData();
+    const QRectF *boundingRects = compiled->boundingRects.constData();
+
     painter->save();
 
     for ( int i = 0; i < numCommands; i++ )
     {
+        if ( doCull && boundingRects[i].isValid() )
+        {
+            const QRectF &pr = pointRects[i];
+            const QRectF &br = boundingRects[i];
+
+            const QRectF rect = pr.adjusted(
+                ( br.left() - pr.left() - 1.0 ) * margin,
+                ( br.top() - pr.top() - 1.0 ) * margin,
+                ( br.right() - pr.right() + 1.0 ) * margin,
+                ( br.bottom() - pr.bottom() + 1.0 ) * margin );
+
+            if ( !qwtIntersects( rect, visibleRect ) )
+                continue;
+        }
+
         qwtExecCommand( painter, commands[i],
             d_data->renderHints, transform, d_data->initialTransform );
     }
@@ -614,6 +846,78 @@ void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     if ( isEmpty() || rect.isEmpty() )
         return;
 
+    CompiledData *compiled = d_data->compiled.data();
+
+    if ( compiled && d_data->rasterCacheSize > 0
+        && QwtPainter::isAligning( painter ) )
+    {
+        const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+        const bool antialiased = painter->testRenderHint( QPainter::Antialiasing );
+
+        QImage image;
+
+        {
+            QMutexLocker locker( &compiled->mutex );
+
+            for ( int i = 0; i < compiled->rasters.size(); i++ )
+            {
+                const QwtGraphicRaster &raster = compiled->rasters[i];
+
+                if ( raster.size == rect.size()
+                    && raster.aspectRatioMode == aspectRatioMode
+                    && raster.antialiased == antialiased
+                    && raster.pixelRatio == pixelRatio )
+                {
+                    image = raster.image;
+
+                    // least recently used at the end
+                    compiled->rasters.move( i, 0 );
+                    break;
+                }
+            }
+        }
+
+        if ( image.isNull() )
+        {
+            image = QImage( qwtCeil( rect.width() * pixelRatio ),
+                qwtCeil( rect.height() * pixelRatio ),
+                QImage::Format_ARGB32_Premultiplied );
+            image.fill( 0 );
+
+#if QT_VERSION >= 0x050000
+            image.setDevicePixelRatio( pixelRatio );
+#endif
+
+            QPainter p( &image );
+            p.setRenderHint( QPainter::Antialiasing, antialiased );
+            renderScaled( &p, QRectF( QPointF( 0.0, 0.0 ), rect.size() ),
+                aspectRatioMode );
+            p.end();
+
+            QwtGraphicRaster raster;
+            raster.size = rect.size();
+            raster.aspectRatioMode = aspectRatioMode;
+            raster.antialiased = antialiased;
+            raster.pixelRatio = pixelRatio;
+            raster.image = image;
+
+            QMutexLocker locker( &compiled->mutex );
+
+            compiled->rasters.prepend( raster );
+            while ( compiled->rasters.size() > d_data->rasterCacheSize )
+                compiled->rasters.removeLast();
+        }
+
+        painter->drawImage( rect.topLeft(), image );
+        return;
+    }
+
+    renderScaled( painter, rect, aspectRatioMode );
+}
+
+void QwtGraphic::renderScaled( QPainter *painter, const QRectF &rect,
+    Qt::AspectRatioMode aspectRatioMode ) const
+{
     double sx = 1.0;
     double sy = 1.0;
 
@@ -865,6 +1169,7 @@ void QwtGraphic::drawPath( const QPainterPath &path )
     if ( painter == NULL )
         return;
 
+    d_data->compiled.clear();
     d_data->commands += QwtPainterCommand( path );
 
     if ( !path.isEmpty() )
@@ -904,6 +1209,7 @@ void QwtGraphic::drawPixmap( const QRectF &rect,
     if ( painter == NULL )
         return;
 
+    d_data->compiled.clear();
     d_data->commands += QwtPainterCommand( rect, pixmap, subRect );
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -928,6 +1234,7 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
     if ( painter == NULL )
         return;
 
+    d_data->compiled.clear();
     d_data->commands += QwtPainterCommand( rect, image, subRect, flags );
 
     const QRectF r = painter->transform().mapRect( rect );
@@ -944,6 +1251,7 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
  */
 void QwtGraphic::updateState( const QPaintEngineState &state)
 {
+    d_data->compiled.clear();
     d_data->commands += QwtPainterCommand( state );
 }
 
@@ -1008,3 +1316,129 @@ void QwtGraphic::setCommands( QVector< QwtPainterCommand > &commands )
 
     painter.end();
 }
+
+/*!
+  \brief Prepare the graphic for being replayed many times
+
+  compile() creates an optimized list of the recorded commands:
+
+  - Consecutive state changes are merged into one command
+  - State changes after the last drawing command are dropped
+  - The bounding rectangles of the paths are stored, so that paths
+    outside of the visible area of the painter can be culled
+
+  Furthermore a compiled graphic can cache rasterized versions of
+  itself for the sizes it has been rendered with, see setRasterCacheSize().
+
+  The compiled commands are discarded, when the graphic is modified.
+
+  \sa isCompiled(), setRasterCacheSize()
+ */
+void QwtGraphic::compile()
+{
+    const int numCommands = d_data->commands.size();
+    const QwtPainterCommand *commands = d_data->commands.constData();
+
+    int lastDrawCommand = -1;
+    for ( int i = numCommands - 1; i >= 0; i-- )
+    {
+        if ( commands[i].type() != QwtPainterCommand::State )
+        {
+            lastDrawCommand = i;
+            break;
+        }
+    }
+
+    CompiledData *compiled = new CompiledData();
+    compiled->commands.reserve( lastDrawCommand + 1 );
+    compiled->pointRects.reserve( lastDrawCommand + 1 );
+    compiled->boundingRects.reserve( lastDrawCommand + 1 );
+
+    int pathIndex = 0;
+
+    for ( int i = 0; i <= lastDrawCommand; i++ )
+    {
+        const QwtPainterCommand &cmd = commands[i];
+
+        if ( cmd.type() == QwtPainterCommand::State
+            && !compiled->commands.isEmpty()
+            && compiled->commands.last().type() == QwtPainterCommand::State )
+        {
+            QwtPainterCommand &lastCmd = compiled->commands.last();
+            if ( qwtCanMergeStates( lastCmd.stateData(), cmd.stateData() ) )
+            {
+                qwtMergeStates( lastCmd.stateData(), cmd.stateData() );
+                continue;
+            }
+        }
+
+        QRectF pointRect;
+        QRectF boundingRect;
+
+        if ( cmd.type() == QwtPainterCommand::Path && !cmd.path()->isEmpty() )
+        {
+            // drawPath() has stored infos for all non empty paths
+            if ( pathIndex < d_data->pathInfos.size() )
+            {
+                const PathInfo &info = d_data->pathInfos[pathIndex];
+
+                pointRect = info.pointRect();
+                boundingRect = info.boundingRect();
+            }
+
+            pathIndex++;
+        }
+
+        compiled->commands += cmd;
+        compiled->pointRects += pointRect;
+        compiled->boundingRects += boundingRect;
+    }
+
+    d_data->compiled = QSharedPointer<CompiledData>( compiled );
+}
+
+/*!
+  \return True, when the graphic has been compiled and not
+          been modified since
+  \sa compile()
+ */
+bool QwtGraphic::isCompiled() const
+{
+    return !d_data->compiled.isNull();
+}
+
+/*!
+  \brief Set the number of rasterized versions, that are cached
+
+  When a compiled graphic is rendered into a rectangle to a paint
+  engine, that aligns to pixels ( see QwtPainter::isAligning() ), it is
+  rasterized once for each size and then painted as image. The least
+  recently used images are removed, when the cache is full.
+
+  The default setting is 0, what disables the cache.
+
+  \param numRasters Maximum number of cached images
+  \sa rasterCacheSize(), compile()
+  \note The position of the cached images is rounded to pixels
+ */
+void QwtGraphic::setRasterCacheSize( int numRasters )
+{
+    d_data->rasterCacheSize = qMax( numRasters, 0 );
+
+    if ( d_data->compiled )
+    {
+        QMutexLocker locker( &d_data->compiled->mutex );
+
+        while ( d_data->compiled->rasters.size() > d_data->rasterCacheSize )
+            d_data->compiled->rasters.removeLast();
+    }
+}
+
+/*!
+  \return Maximum number of cached images
+  \sa setRasterCacheSize()
+ */
+int QwtGraphic::rasterCacheSize() const
+{
+    return d_data->rasterCacheSize;
+}
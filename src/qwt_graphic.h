@@ -148,6 +148,12 @@ public:
     void setRenderHint( RenderHint, bool on = true );
     bool testRenderHint( RenderHint ) const;
 
+    void compile();
+    bool isCompiled() const;
+
+    void setRasterCacheSize( int numRasters );
+    int rasterCacheSize() const;
+
 protected:
     virtual QSize sizeMetrics() const QWT_OVERRIDE;
 
@@ -165,7 +171,10 @@ private:
     void updateBoundingRect( const QRectF & );
     void updateControlPointRect( const QRectF & );
 
+    void renderScaled( QPainter *, const QRectF &, Qt::AspectRatioMode ) const;
+
     class PathInfo;
+    class CompiledData;
 
     class PrivateData;
     PrivateData *d_data;
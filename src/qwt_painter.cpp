@@ -27,6 +27,17 @@
 #include <qpaintengine.h>
 #include <qapplication.h>
 #include <qdesktopwidget.h>
+#include <qelapsedtimer.h>
+#include <qmutex.h>
+#include <qatomic.h>
+#include <qmap.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+
+#if QT_VERSION >= 0x050000
+#include <qguiapplication.h>
+#include <qscreen.h>
+#endif
 
 #if QT_VERSION < 0x050000
 
@@ -36,11 +47,11 @@
 
 #endif
 
-#include <cstring>
-
 bool QwtPainter::d_polylineSplitting = true;
 bool QwtPainter::d_roundingAlignment = true;
 
+static QAtomicPointer<QThreadPool> qwtThreadPool;
+
 static inline bool qwtIsRasterPaintEngineBuggy()
 {
 #if 0
@@ -101,101 +112,264 @@ static inline bool qwtIsClippingNeeded(
     return doClipping;
 }
 
-template <class T>
-static inline void qwtDrawPolyline( QPainter *painter,
-    const T *points, int pointCount, bool polylineSplitting )
+namespace
 {
-    bool doSplit = false;
-    if ( polylineSplitting && pointCount > 3 )
+    class QwtPolylineBatching
     {
-        const QPaintEngine *pe = painter->paintEngine();
-        if ( pe && pe->type() == QPaintEngine::Raster )
+    public:
+        enum { EngineCount = QPaintEngine::MaxUser + 1 };
+
+        QwtPolylineBatching()
         {
-            if ( painter->pen().width() <= 1 )
-            {
-#if QT_VERSION < 0x040800
-                if ( painter->renderHints() & QPainter::Antialiasing )
-                {
-                    /*
-                        all versions <= 4.7 have issues with
-                        antialiased lines
-                     */
+            // QAtomicInt is initialized with 0
+
+            /*
+                Stroking wide lines is much faster for the raster
+                and OpenGL paint engines, when the joins are calculated
+                for short pieces. Vector formats ( PDF, SVG, Postscript )
+                would only end up with larger documents and visible
+                gaps at the joins, so they get the polyline in one piece.
+
+                The values are not measured at runtime, as this would
+                mean painting test polylines for each new paint device.
+                The raster value is the one Qwt has always been using,
+                the OpenGL value is a conservative default, that has
+                not been measured yet. Both can be tuned with the
+                benchmark in playground/polylines.
+             */
+            chunkSizes[QPaintEngine::Raster].fetchAndStoreOrdered( 6 );
+            chunkSizes[QPaintEngine::OpenGL].fetchAndStoreOrdered( 256 );
+            chunkSizes[QPaintEngine::OpenGL2].fetchAndStoreOrdered( 256 );
+        }
 
-                    doSplit = true;
-                }
-#endif
-                // work around a bug with short lines below 2 pixels difference
-                // in height and width
+        int chunkSize( int engineType )
+        {
+            return chunkSizes[engineType].fetchAndAddOrdered( 0 );
+        }
 
-                doSplit = qwtIsRasterPaintEngineBuggy();
-            }
-            else
-            {
-                /*
-                   Raster paint engine is much faster when splitting
-                   the polygon, but of course we might see some issues where
-                   the pieces are joining
-                 */
-                doSplit = true;
-            }
+        void setChunkSize( int engineType, int size )
+        {
+            chunkSizes[engineType].fetchAndStoreOrdered( size );
         }
-    }
 
-    if ( doSplit )
-    {
-        QPen pen = painter->pen();
+        bool isProfiling()
+        {
+            return profiling.fetchAndAddOrdered( 0 ) != 0;
+        }
 
-        const int splitSize = 6;
+        void setProfiling( bool on )
+        {
+            profiling.fetchAndStoreOrdered( on ? 1 : 0 );
+        }
 
-        if ( pen.width() <= 1 && pen.isSolid() && qwtIsRasterPaintEngineBuggy()
-            && !( painter->renderHints() & QPainter::Antialiasing ) )
+        static inline bool isValidEngine( int engineType )
         {
-            int k = 0;
+            return engineType >= 0 && engineType < EngineCount;
+        }
 
-            for ( int i = k + 1; i < pointCount; i++ )
-            {
-                const QPointF &p1 = points[i-1];
-                const QPointF &p2 = points[i];
+        QMutex mutex;
+        QMap< int, QwtPainter::PolylineStatistics > statistics;
 
-                const bool isBad = ( qAbs( p2.y() - p1.y() ) <= 1 )
-                    &&  qAbs( p2.x() - p1.x() ) <= 1;
+    private:
+        // settings, that are read from all painting threads
+        QAtomicInt chunkSizes[EngineCount];
+        QAtomicInt profiling;
+    };
+}
 
-                if ( isBad || ( i - k >= splitSize ) )
-                {
-                    painter->drawPolyline( points + k, i - k + 1 );
-                    k = i;
-                }
+static QwtPolylineBatching *qwtPolylineBatching()
+{
+    static QwtPolylineBatching batching;
+    return &batching;
+}
+
+static inline int qwtPolylineChunkSize(
+    const QPainter *painter, int engineType )
+{
+    if ( !QwtPolylineBatching::isValidEngine( engineType ) )
+        return 0;
+
+    const QPen pen = painter->pen();
+    if ( pen.width() <= 1 )
+    {
+        /*
+            Cosmetic lines are painted by the fast path
+            of the paint engine, that handles polylines of
+            any size. We only have to work around bugs.
+         */
+        if ( engineType == QPaintEngine::Raster )
+        {
+#if QT_VERSION < 0x040800
+            if ( painter->renderHints() & QPainter::Antialiasing )
+            {
+                /*
+                    all versions <= 4.7 have issues with
+                    antialiased lines
+                 */
+                return 6;
             }
+#endif
+            // work around a bug with short lines below 2 pixels difference
+            // in height and width
 
-            painter->drawPolyline( points + k, pointCount - k );
+            if ( qwtIsRasterPaintEngineBuggy() )
+                return 6;
         }
-        else
+
+        return 0;
+    }
+
+    return qwtPolylineBatching()->chunkSize( engineType );
+}
+
+template <class T>
+static inline int qwtDrawPolylineChunks( QPainter *painter,
+    const T *points, int pointCount, int chunkSize )
+{
+    const QPen pen = painter->pen();
+
+    if ( pen.width() <= 1 && pen.isSolid() && qwtIsRasterPaintEngineBuggy()
+        && !( painter->renderHints() & QPainter::Antialiasing ) )
+    {
+        int numChunks = 0;
+        int k = 0;
+
+        for ( int i = k + 1; i < pointCount; i++ )
         {
-            for ( int i = 0; i < pointCount; i += splitSize )
+            const QPointF &p1 = points[i-1];
+            const QPointF &p2 = points[i];
+
+            const bool isBad = ( qAbs( p2.y() - p1.y() ) <= 1 )
+                &&  qAbs( p2.x() - p1.x() ) <= 1;
+
+            if ( isBad || ( i - k >= chunkSize ) )
             {
-                const int n = qMin( splitSize + 1, pointCount - i );
-                painter->drawPolyline( points + i, n );
+                painter->drawPolyline( points + k, i - k + 1 );
+                numChunks++;
+
+                k = i;
             }
         }
+
+        painter->drawPolyline( points + k, pointCount - k );
+
+        return numChunks + 1;
+    }
+
+    int numChunks = 0;
+    for ( int i = 0; i < pointCount - 1; i += chunkSize )
+    {
+        const int n = qMin( chunkSize + 1, pointCount - i );
+        painter->drawPolyline( points + i, n );
+
+        numChunks++;
+    }
+
+    return numChunks;
+}
+
+template <class T>
+static inline void qwtDrawPolyline( QPainter *painter,
+    const T *points, int pointCount, bool polylineSplitting )
+{
+    if ( pointCount <= 0 || painter->pen().style() == Qt::NoPen )
+        return;
+
+    const QPaintEngine *pe = painter->paintEngine();
+    const int engineType = pe ? int( pe->type() ) : -1;
+
+    QwtPolylineBatching *batching = qwtPolylineBatching();
+
+    const bool profiling = batching->isProfiling();
+
+    QElapsedTimer timer;
+    if ( profiling )
+        timer.start();
+
+    int chunkSize = 0;
+    if ( polylineSplitting && pointCount > 3 )
+        chunkSize = qwtPolylineChunkSize( painter, engineType );
+
+    int numChunks = 1;
+
+    if ( chunkSize > 0 && pointCount > chunkSize + 1 )
+    {
+        numChunks = qwtDrawPolylineChunks( painter,
+            points, pointCount, chunkSize );
     }
     else
     {
         painter->drawPolyline( points, pointCount );
     }
+
+    if ( profiling )
+    {
+#if QT_VERSION >= 0x040800
+        const qint64 elapsed = timer.nsecsElapsed();
+#else
+        const qint64 elapsed = timer.elapsed() * 1000000;
+#endif
+
+        QMutexLocker locker( &batching->mutex );
+
+        QwtPainter::PolylineStatistics &statistics =
+            batching->statistics[engineType];
+
+        statistics.polylineCount++;
+        statistics.pointCount += pointCount;
+        statistics.chunkCount += numChunks;
+        statistics.elapsed += elapsed;
+    }
+}
+
+static inline QWidget *qwtDesktopWidget()
+{
+    /*
+        QDesktopWidget is a widget: it can't be used without
+        a QApplication ( f.e. headless with a QGuiApplication )
+        and from other threads than the GUI thread
+     */
+    if ( qobject_cast<const QApplication *>( QCoreApplication::instance() )
+        && QwtPainter::isGuiThread() )
+    {
+        return QApplication::desktop();
+    }
+
+    return NULL;
+}
+
+static QSize qwtDesktopResolution()
+{
+    QSize resolution;
+
+#if QT_VERSION >= 0x050000
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    if ( screen )
+    {
+        resolution.setWidth( qRound( screen->logicalDotsPerInchX() ) );
+        resolution.setHeight( qRound( screen->logicalDotsPerInchY() ) );
+    }
+#else
+    const QWidget *desktop = qwtDesktopWidget();
+    if ( desktop )
+    {
+        resolution.setWidth( desktop->logicalDpiX() );
+        resolution.setHeight( desktop->logicalDpiY() );
+    }
+#endif
+
+    return resolution;
 }
 
 static inline QSize qwtScreenResolution()
 {
+    static QMutex mutex;
     static QSize screenResolution;
+
+    QMutexLocker locker( &mutex );
+
     if ( !screenResolution.isValid() )
-    {
-        QDesktopWidget *desktop = QApplication::desktop();
-        if ( desktop )
-        {
-            screenResolution.setWidth( desktop->logicalDpiX() );
-            screenResolution.setHeight( desktop->logicalDpiY() );
-        }
-    }
+        screenResolution = qwtDesktopResolution();
 
     return screenResolution;
 }
@@ -206,13 +380,32 @@ static inline void qwtUnscaleFont( QPainter *painter )
         return;
 
     const QSize screenResolution = qwtScreenResolution();
+    if ( !screenResolution.isValid() )
+        return;
 
     const QPaintDevice *pd = painter->device();
     if ( pd->logicalDpiX() != screenResolution.width() ||
         pd->logicalDpiY() != screenResolution.height() )
     {
-        QFont pixelFont( painter->font(), QApplication::desktop() );
-        pixelFont.setPixelSize( QFontInfo( pixelFont ).pixelSize() );
+        QFont pixelFont( painter->font() );
+
+        QWidget *desktop = qwtDesktopWidget();
+        if ( desktop )
+        {
+            pixelFont = QFont( painter->font(), desktop );
+            pixelFont.setPixelSize( QFontInfo( pixelFont ).pixelSize() );
+        }
+        else
+        {
+            // without QDesktopWidget the font is scaled by the resolution
+
+            const qreal pointSize = pixelFont.pointSizeF();
+            if ( pointSize <= 0.0 )
+                return;
+
+            pixelFont.setPixelSize( qRound( pointSize
+                * screenResolution.height() / 72.0 ) );
+        }
 
         painter->setFont( pixelFont );
     }
@@ -323,15 +516,102 @@ void QwtPainter::setRoundingAlignment( bool enable )
   for short lines ( https://codereview.qt-project.org/#/c/99456 ), that is worked
   around in this mode.
 
+  The size of the chunks depends on the type of the paint engine.
+
   The default setting is true.
 
-  \sa polylineSplitting()
+  \sa polylineSplitting(), setPolylineChunkSize()
 */
 void QwtPainter::setPolylineSplitting( bool enable )
 {
     d_polylineSplitting = enable;
 }
 
+/*!
+  \brief Set the number of line segments, that are painted in one piece
+
+  When polylineSplitting() is enabled, polylines with a pen width > 1
+  are split into chunks of chunkSize segments, before they are passed
+  to a paint engine of the given type. Cosmetic lines are always painted
+  in one piece, beside working around bugs of the raster paint engine.
+
+  The default settings are 6 for QPaintEngine::Raster, 256 for
+  QPaintEngine::OpenGL/OpenGL2 and 0 ( no splitting ) for all other
+  paint engines.
+
+  \param engineType Type of the paint engine, see QPaintEngine::Type
+  \param chunkSize Number of line segments, <= 0 disables splitting
+
+  \sa polylineChunkSize(), setPolylineSplitting()
+*/
+void QwtPainter::setPolylineChunkSize( int engineType, int chunkSize )
+{
+    if ( QwtPolylineBatching::isValidEngine( engineType ) )
+        qwtPolylineBatching()->setChunkSize( engineType, qMax( chunkSize, 0 ) );
+}
+
+/*!
+  \param engineType Type of the paint engine, see QPaintEngine::Type
+  \return Number of line segments, that are painted in one piece
+  \sa setPolylineChunkSize()
+*/
+int QwtPainter::polylineChunkSize( int engineType )
+{
+    if ( QwtPolylineBatching::isValidEngine( engineType ) )
+        return qwtPolylineBatching()->chunkSize( engineType );
+
+    return 0;
+}
+
+/*!
+  \brief En/Disable collecting statistics about painting polylines
+
+  When enabled the number of polylines, points, chunks and the time
+  spent in the paint engine are counted for each type of paint engine.
+  As measuring the time has some overhead profiling is disabled
+  by default.
+
+  \sa polylineStatistics(), resetPolylineStatistics()
+*/
+void QwtPainter::setPolylineProfiling( bool on )
+{
+    qwtPolylineBatching()->setProfiling( on );
+}
+
+/*!
+  \return True, when statistics about painting polylines are collected
+  \sa setPolylineProfiling()
+*/
+bool QwtPainter::polylineProfiling()
+{
+    return qwtPolylineBatching()->isProfiling();
+}
+
+/*!
+  \param engineType Type of the paint engine, see QPaintEngine::Type
+  \return Statistics about painting polylines to a paint engine
+  \sa setPolylineProfiling(), resetPolylineStatistics()
+*/
+QwtPainter::PolylineStatistics QwtPainter::polylineStatistics( int engineType )
+{
+    QwtPolylineBatching *batching = qwtPolylineBatching();
+
+    QMutexLocker locker( &batching->mutex );
+    return batching->statistics.value( engineType );
+}
+
+/*!
+  Reset the statistics about painting polylines for all paint engines
+  \sa polylineStatistics()
+*/
+void QwtPainter::resetPolylineStatistics()
+{
+    QwtPolylineBatching *batching = qwtPolylineBatching();
+
+    QMutexLocker locker( &batching->mutex );
+    batching->statistics.clear();
+}
+
 //! Wrapper for QPainter::drawPath()
 void QwtPainter::drawPath( QPainter *painter, const QPainterPath &path )
 {
@@ -598,10 +878,10 @@ void QwtPainter::drawPolyline( QPainter *painter,
 
     if ( deviceClipping )
     {
-        QPolygonF polygon( pointCount );
-        std::memcpy( polygon.data(), points, pointCount * sizeof( QPointF ) );
+        QPolygonF polygon;
+        polygon.reserve( pointCount );
 
-        QwtClipper::clipPolygonF( clipRect, polygon );
+        QwtClipper::clipPolygonF( clipRect, points, pointCount, polygon );
         qwtDrawPolyline<QPointF>( painter,
             polygon.constData(), polygon.size(), d_polylineSplitting );
     }
@@ -657,10 +937,10 @@ void QwtPainter::drawPolyline( QPainter *painter,
 
     if ( deviceClipping )
     {
-        QPolygon polygon( pointCount );
-        std::memcpy( polygon.data(), points, pointCount * sizeof( QPoint ) );
+        QPolygon polygon;
+        polygon.reserve( pointCount );
 
-        QwtClipper::clipPolygon( clipRect, polygon );
+        QwtClipper::clipPolygon( clipRect, points, pointCount, polygon );
         qwtDrawPolyline<QPoint>( painter,
             polygon.constData(), polygon.size(), d_polylineSplitting );
     }
@@ -1442,3 +1722,59 @@ QPixmap QwtPainter::backingStore( QWidget *widget, const QSize &size )
 
     return pm;
 }
+
+/*!
+  \return True, when the calling thread is the thread of the application
+ */
+bool QwtPainter::isGuiThread()
+{
+    const QCoreApplication *app = QCoreApplication::instance();
+    return ( app != NULL ) && ( QThread::currentThread() == app->thread() );
+}
+
+/*!
+  \brief Font, that uses screen metrics
+
+  QDesktopWidget must not be accessed from other threads than
+  the GUI thread and is not available without a QApplication.
+  But then fonts without a paint device are in screen metrics anyway.
+
+  \param font Font
+  \return Font in screen metrics
+ */
+QFont QwtPainter::screenFont( const QFont &font )
+{
+    QWidget *desktop = qwtDesktopWidget();
+    if ( desktop == NULL )
+        return font;
+
+    return QFont( font, desktop );
+}
+
+/*!
+  \brief Set the thread pool for parallel painting operations
+
+  Painting operations, that can be split into independent
+  parts - f.e. stamping the symbols of a QwtSymbol into a QImage -
+  run them on this pool. The pool is not owned by QwtPainter.
+
+  QwtRenderScheduler installs its pool, so that its thread limits
+  are respected. Without a pool all parts are painted in the
+  calling thread.
+
+  \param pool Thread pool, or NULL
+  \sa threadPool()
+ */
+void QwtPainter::setThreadPool( QThreadPool *pool )
+{
+    qwtThreadPool.fetchAndStoreOrdered( pool );
+}
+
+/*!
+  \return Thread pool for parallel painting operations, or NULL
+  \sa setThreadPool()
+ */
+QThreadPool *QwtPainter::threadPool()
+{
+    return qwtThreadPool.fetchAndAddOrdered( 0 );
+}
@@ -17,10 +17,12 @@
 #include <qpen.h>
 
 class QPainter;
+class QFont;
 class QBrush;
 class QWidget;
 class QImage;
 class QPixmap;
+class QThreadPool;
 class QwtScaleMap;
 class QwtColorMap;
 class QwtInterval;
@@ -34,9 +36,46 @@ class QPainterPath;
 class QWT_EXPORT QwtPainter
 {
 public:
+    /*!
+      \brief Counters for the polylines painted to a type of paint engine
+      \sa setPolylineProfiling(), polylineStatistics()
+     */
+    class PolylineStatistics
+    {
+    public:
+        PolylineStatistics():
+            polylineCount( 0 ),
+            pointCount( 0 ),
+            chunkCount( 0 ),
+            elapsed( 0 )
+        {
+        }
+
+        //! Number of calls of QwtPainter::drawPolyline()
+        qint64 polylineCount;
+
+        //! Number of points of all polylines
+        qint64 pointCount;
+
+        //! Number of QPainter::drawPolyline() calls
+        qint64 chunkCount;
+
+        //! Time spent in the paint engine in nanoseconds
+        qint64 elapsed;
+    };
+
     static void setPolylineSplitting( bool );
     static bool polylineSplitting();
 
+    static void setPolylineChunkSize( int engineType, int chunkSize );
+    static int polylineChunkSize( int engineType );
+
+    static void setPolylineProfiling( bool );
+    static bool polylineProfiling();
+
+    static PolylineStatistics polylineStatistics( int engineType );
+    static void resetPolylineStatistics();
+
     static void setRoundingAlignment( bool );
     static bool roundingAlignment();
     static bool roundingAlignment( const QPainter * );
@@ -117,6 +156,12 @@ public:
 
     static qreal effectivePenWidth( const QPen & );
 
+    static bool isGuiThread();
+    static QFont screenFont( const QFont & );
+
+    static void setThreadPool( QThreadPool * );
+    static QThreadPool *threadPool();
+
 private:
     static bool d_polylineSplitting;
     static bool d_roundingAlignment;
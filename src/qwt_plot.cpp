@@ -17,12 +17,17 @@
 #include "qwt_legend.h"
 #include "qwt_legend_data.h"
 #include "qwt_plot_canvas.h"
+#include "qwt_painter.h"
+#include "qwt_render_scheduler.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qpaintengine.h>
 #include <qpointer.h>
 #include <qapplication.h>
 #include <qcoreevent.h>
+#include <qelapsedtimer.h>
+#include <qimage.h>
 
 static inline void qwtEnableLegendItems( QwtPlot *plot, bool on )
 {
@@ -84,6 +89,134 @@ static void qwtSetTabOrder(
     }
 }
 
+static void qwtDrawItem( QPainter *painter, const QwtPlotItem *item,
+    const QwtScaleMap maps[], const QRectF &canvasRect )
+{
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    item->draw( painter,
+        maps[item->xAxis()], maps[item->yAxis()],
+        canvasRect );
+
+    painter->restore();
+}
+
+class QwtPlotLayerTask: public QwtRenderScheduler::Task
+{
+public:
+    virtual void renderPart( int index, int numParts ) QWT_OVERRIDE
+    {
+        const int from = index * items.size() / numParts;
+        const int to = ( index + 1 ) * items.size() / numParts;
+
+        QImage &layer = layers[index];
+
+        layer = QImage( rect.size() * pixelRatio,
+            QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+        layer.setDevicePixelRatio( pixelRatio );
+#endif
+        layer.fill( Qt::transparent );
+
+        QPainter painter( &layer );
+        painter.translate( -rect.topLeft() );
+        painter.setFont( font );
+        painter.setPen( pen );
+        painter.setBrush( brush );
+
+        for ( int i = from; i < to; i++ )
+            qwtDrawItem( &painter, items[i], maps, canvasRect );
+    }
+
+    QList<const QwtPlotItem *> items;
+    const QwtScaleMap *maps;
+    QRectF canvasRect;
+
+    QRect rect;
+    qreal pixelRatio;
+
+    QFont font;
+    QPen pen;
+    QBrush brush;
+
+    QVector<QImage> layers;
+};
+
+static bool qwtCanRenderLayers( const QPainter *painter )
+{
+    // layers are images: vector devices have to be painted directly
+
+    const QPaintEngine *engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::Raster )
+        return false;
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
+static void qwtDrawItemsConcurrently( QPainter *painter,
+    const QwtScaleMap maps[], const QRectF &canvasRect,
+    const QList<const QwtPlotItem *> &items )
+{
+    QwtRenderScheduler *scheduler = QwtRenderScheduler::instance();
+
+    uint numThreads = 1;
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        numThreads = qMax( numThreads,
+            scheduler->threadCount( items[i]->renderThreadCount() ) );
+    }
+
+    numThreads = qMin( numThreads, static_cast<uint>( items.size() ) );
+
+    if ( numThreads <= 1 )
+    {
+        for ( int i = 0; i < items.size(); i++ )
+            qwtDrawItem( painter, items[i], maps, canvasRect );
+
+        return;
+    }
+
+    /*
+        Each thread renders a contiguous range of the items into
+        a layer of its own. As composing with QPainter::CompositionMode_SourceOver
+        is associative the result is the same as painting the
+        items one after the other.
+     */
+
+    QwtPlotLayerTask task;
+    task.items = items;
+    task.maps = maps;
+    task.canvasRect = canvasRect;
+    task.rect = canvasRect.toAlignedRect();
+    task.pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    task.font = painter->font();
+    task.pen = painter->pen();
+    task.brush = painter->brush();
+    task.layers.resize( numThreads );
+
+    if ( !scheduler->run( items.first(), &task, numThreads ) )
+    {
+        // The render has been cancelled, but the paint event still
+        // needs all items. Layers, that have not been started, are
+        // rendered in the calling thread.
+
+        for ( int i = 0; i < task.layers.size(); i++ )
+        {
+            if ( task.layers[i].isNull() )
+                task.renderPart( i, task.layers.size() );
+        }
+    }
+
+    for ( int i = 0; i < task.layers.size(); i++ )
+        painter->drawImage( task.rect.topLeft(), task.layers[i] );
+}
+
 class QwtPlot::PrivateData
 {
 public:
@@ -94,6 +227,16 @@ public:
     QwtPlotLayout *layout;
 
     bool autoReplot;
+
+    int replotInterval;
+    int replotTimerId;
+
+    QElapsedTimer frameClock;
+    qint64 lastReplot;
+    qint64 replotDeadline;
+
+    int mergedReplots;
+    int droppedFrames;
 };
 
 /*!
@@ -123,6 +266,8 @@ QwtPlot::~QwtPlot()
     setAutoReplot( false );
     detachItems( QwtPlotItem::Rtti_PlotItem, autoDelete() );
 
+    QwtRenderScheduler::instance()->releasePlot( this );
+
     delete d_data->layout;
     deleteAxesData();
     delete d_data;
@@ -139,6 +284,14 @@ void QwtPlot::initPlot( const QwtText &title )
     d_data->layout = new QwtPlotLayout;
     d_data->autoReplot = false;
 
+    d_data->replotInterval = 0;
+    d_data->replotTimerId = 0;
+    d_data->lastReplot = -1;
+    d_data->replotDeadline = -1;
+    d_data->mergedReplots = 0;
+    d_data->droppedFrames = 0;
+    d_data->frameClock.start();
+
     // title
     d_data->titleLabel = new QwtTextLabel( this );
     d_data->titleLabel->setObjectName( "QwtPlotTitle" );
@@ -282,11 +435,167 @@ bool QwtPlot::eventFilter( QObject *object, QEvent *event )
     return QFrame::eventFilter( object, event );
 }
 
-//! Replots the plot if autoReplot() is \c true.
+/*!
+  \brief Replots the plot if autoReplot() is \c true.
+
+  When a replotInterval() has been set, the replot is
+  scheduled instead of being executed immediately.
+
+  \sa scheduleReplot()
+ */
 void QwtPlot::autoRefresh()
 {
     if ( d_data->autoReplot )
+        scheduleReplot();
+}
+
+/*!
+  \brief Request a replot, that is merged with other requests
+
+  When replotInterval() is > 0 all requests that arrive before
+  the end of the current frame interval are merged into one
+  replot, that is executed from the event loop. Otherwise
+  replot() is called immediately.
+
+  \sa setReplotInterval(), mergedReplots(), replot()
+ */
+void QwtPlot::scheduleReplot()
+{
+    if ( d_data->replotInterval <= 0 )
+    {
+        replot();
+        return;
+    }
+
+    if ( d_data->replotTimerId != 0 )
+    {
+        d_data->mergedReplots++;
+        return;
+    }
+
+    const qint64 now = d_data->frameClock.elapsed();
+
+    qint64 delay = 0;
+    if ( d_data->lastReplot >= 0 )
+    {
+        delay = d_data->lastReplot + d_data->replotInterval - now;
+        if ( delay < 0 )
+            delay = 0;
+    }
+
+    d_data->replotDeadline = now + delay;
+    d_data->replotTimerId = startTimer( static_cast<int>( delay ) );
+}
+
+/*!
+  \brief Set the minimum interval between two scheduled replots
+
+  Replot requests from scheduleReplot() - or autoRefresh()
+  when autoReplot() is enabled - are coalesced, so that at most
+  one replot is executed for each interval. F.e. an interval
+  of 16ms limits the plot to ~60 frames per second, regardless
+  of how often the data or the scales are modified.
+
+  Explicit calls of replot() are always executed immediately
+  and satisfy a pending scheduled replot.
+
+  \param msecs Interval in milliseconds. A value <= 0 disables
+               coalescing, what is the default setting.
+
+  \sa replotInterval(), scheduleReplot()
+ */
+void QwtPlot::setReplotInterval( int msecs )
+{
+    msecs = qMax( msecs, 0 );
+    if ( msecs == d_data->replotInterval )
+        return;
+
+    d_data->replotInterval = msecs;
+
+    if ( msecs == 0 && d_data->replotTimerId != 0 )
+    {
+        // flush the pending request
         replot();
+    }
+}
+
+/*!
+  \return Minimum interval between two scheduled replots in ms
+  \sa setReplotInterval()
+ */
+int QwtPlot::replotInterval() const
+{
+    return d_data->replotInterval;
+}
+
+/*!
+  \return True, when a scheduled replot has not been executed yet
+  \sa scheduleReplot()
+ */
+bool QwtPlot::isReplotPending() const
+{
+    return d_data->replotTimerId != 0;
+}
+
+/*!
+  \return Number of replot requests, that have been merged into
+          a pending replot since the last resetReplotStatistics()
+
+  \sa droppedFrames(), scheduleReplot()
+ */
+int QwtPlot::mergedReplots() const
+{
+    return d_data->mergedReplots;
+}
+
+/*!
+  A frame is counted as dropped, when a scheduled replot is
+  executed one or more frame intervals behind its deadline,
+  f.e. because the event loop was blocked by a slow paint operation.
+
+  \return Number of dropped frames since the last resetReplotStatistics()
+  \sa mergedReplots(), replotInterval()
+ */
+int QwtPlot::droppedFrames() const
+{
+    return d_data->droppedFrames;
+}
+
+/*!
+  Reset the counters for merged replots and dropped frames
+  \sa mergedReplots(), droppedFrames()
+ */
+void QwtPlot::resetReplotStatistics()
+{
+    d_data->mergedReplots = 0;
+    d_data->droppedFrames = 0;
+}
+
+/*!
+  \brief Qt timer event
+
+  Executes replots, that have been scheduled by scheduleReplot()
+
+  \param event Timer event
+ */
+void QwtPlot::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() != d_data->replotTimerId )
+    {
+        QFrame::timerEvent( event );
+        return;
+    }
+
+    if ( d_data->replotInterval > 0 )
+    {
+        const qint64 delay = d_data->frameClock.elapsed()
+            - d_data->replotDeadline;
+
+        if ( delay >= d_data->replotInterval )
+            d_data->droppedFrames += int( delay / d_data->replotInterval );
+    }
+
+    replot();
 }
 
 /*!
@@ -534,10 +843,21 @@ void QwtPlot::resizeEvent( QResizeEvent *e )
   or if any curves are attached to raw data, the plot has to
   be refreshed explicitly in order to make changes visible.
 
-  \sa updateAxes(), setAutoReplot()
+  A pending replot, that has been requested by scheduleReplot(),
+  is satisfied by this call.
+
+  \sa updateAxes(), setAutoReplot(), scheduleReplot()
 */
 void QwtPlot::replot()
 {
+    if ( d_data->replotTimerId != 0 )
+    {
+        killTimer( d_data->replotTimerId );
+        d_data->replotTimerId = 0;
+    }
+
+    d_data->lastReplot = d_data->frameClock.elapsed();
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
@@ -751,26 +1071,46 @@ void QwtPlot::drawItems( QPainter *painter, const QRectF &canvasRect,
         const QwtScaleMap maps[axisCnt] ) const
 {
     const QwtPlotItemList& itmList = itemList();
-    for ( QwtPlotItemIterator it = itmList.begin();
-        it != itmList.end(); ++it )
+
+    const bool doLayers = qwtCanRenderLayers( painter );
+
+    for ( int i = 0; i < itmList.size(); i++ )
     {
-        QwtPlotItem *item = *it;
-        if ( item && item->isVisible() )
+        const QwtPlotItem *item = itmList[i];
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        if ( doLayers &&
+            item->testItemAttribute( QwtPlotItem::ConcurrentRendering ) )
         {
-            painter->save();
+            QList<const QwtPlotItem *> items;
 
-            painter->setRenderHint( QPainter::Antialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+            int j = i;
+            for ( ; j < itmList.size(); j++ )
+            {
+                const QwtPlotItem *layerItem = itmList[j];
+                if ( layerItem == NULL || !layerItem->isVisible() )
+                    continue;
 
-            painter->setRenderHint( QPainter::HighQualityAntialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+                if ( !layerItem->testItemAttribute(
+                    QwtPlotItem::ConcurrentRendering ) )
+                {
+                    break;
+                }
 
-            item->draw( painter,
-                maps[item->xAxis()], maps[item->yAxis()],
-                canvasRect );
+                items += layerItem;
+            }
 
-            painter->restore();
+            if ( items.size() > 1 )
+            {
+                qwtDrawItemsConcurrently( painter, maps, canvasRect, items );
+
+                i = j - 1;
+                continue;
+            }
         }
+
+        qwtDrawItem( painter, item, maps, canvasRect );
     }
 }
 
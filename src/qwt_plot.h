@@ -79,6 +79,8 @@ class QWT_EXPORT QwtPlot: public QFrame, public QwtPlotDict
     Q_PROPERTY( QBrush canvasBackground
         READ canvasBackground WRITE setCanvasBackground )
     Q_PROPERTY( bool autoReplot READ autoReplot WRITE setAutoReplot )
+    Q_PROPERTY( int replotInterval
+        READ replotInterval WRITE setReplotInterval )
 
 #if 0
     // This property is intended to configure the plot
@@ -140,6 +142,15 @@ public:
     void setAutoReplot( bool = true );
     bool autoReplot() const;
 
+    void setReplotInterval( int msecs );
+    int replotInterval() const;
+
+    bool isReplotPending() const;
+
+    int mergedReplots() const;
+    int droppedFrames() const;
+    void resetReplotStatistics();
+
     // Layout
 
     void setPlotLayout( QwtPlotLayout * );
@@ -189,6 +200,11 @@ public:
     void setAxisAutoScale( int axisId, bool on = true );
     bool axisAutoScale( int axisId ) const;
 
+    void setAxisAutoScaleHysteresis( int axisId,
+        bool on = true, double headroom = 0.1 );
+    bool axisAutoScaleHysteresis( int axisId ) const;
+    double axisAutoScaleHeadroom( int axisId ) const;
+
     void enableAxis( int axisId, bool tf = true );
     bool axisEnabled( int axisId ) const;
 
@@ -282,12 +298,14 @@ Q_SIGNALS:
 
 public Q_SLOTS:
     virtual void replot();
+    void scheduleReplot();
     void autoRefresh();
 
 protected:
     static bool axisValid( int axisId );
 
     virtual void resizeEvent( QResizeEvent * ) QWT_OVERRIDE;
+    virtual void timerEvent( QTimerEvent * ) QWT_OVERRIDE;
 
 private Q_SLOTS:
     void updateLegendItems( const QVariant &itemInfo,
@@ -13,6 +13,72 @@
 #include "qwt_scale_div.h"
 #include "qwt_scale_engine.h"
 #include "qwt_interval.h"
+#include "qwt_transform.h"
+#include "qwt_render_scheduler.h"
+
+static inline double qwtTransformed( const QwtTransform *transform, double value )
+{
+    // values outside of the domain of the transformation ( f.e <= 0 for
+    // logarithmic scales ) are bounded, to avoid NaN or infinite values
+
+    return transform ? transform->transform( transform->bounded( value ) ) : value;
+}
+
+static inline double qwtInvTransformed( const QwtTransform *transform, double value )
+{
+    return transform ? transform->bounded( transform->invTransform( value ) ) : value;
+}
+
+static bool qwtIsReusable( const QwtScaleDiv &scaleDiv,
+    const QwtInterval &interval, double headroom,
+    const QwtTransform *transform, QwtScaleEngine *scaleEngine, int maxMajor )
+{
+    const QwtInterval scaleInterval = scaleDiv.interval().normalized();
+
+    double minValue = interval.minValue();
+    double maxValue = interval.maxValue();
+
+    if ( transform )
+    {
+        minValue = transform->bounded( minValue );
+        maxValue = transform->bounded( maxValue );
+    }
+
+    if ( !scaleInterval.contains( minValue )
+        || !scaleInterval.contains( maxValue ) )
+    {
+        return false;
+    }
+
+    // the scale is recalculated, when the data shrinks to less
+    // than half of the width, that would be needed including its headroom
+
+    const double scaleWidth = qAbs( qwtTransformed( transform, scaleInterval.maxValue() )
+        - qwtTransformed( transform, scaleInterval.minValue() ) );
+
+    double neededWidth = ( 1.0 + 2.0 * headroom ) * qAbs(
+        qwtTransformed( transform, maxValue ) - qwtTransformed( transform, minValue ) );
+
+    if ( neededWidth == 0.0 )
+    {
+        // constant data: the width is the one, that would be
+        // calculated by the scale engine for the value
+
+        double x1 = minValue;
+        double x2 = maxValue;
+        double stepSize = 0.0;
+
+        scaleEngine->autoScale( maxMajor, x1, x2, stepSize );
+
+        neededWidth = qAbs( qwtTransformed( transform, x2 )
+            - qwtTransformed( transform, x1 ) );
+
+        if ( neededWidth == 0.0 )
+            return true;
+    }
+
+    return 2.0 * neededWidth >= scaleWidth;
+}
 
 class QwtPlot::AxisData
 {
@@ -29,6 +95,12 @@ public:
 
     bool isValid;
 
+    bool hysteresis;
+    double headroom;
+
+    bool isAutoScaled;
+    QwtScaleEngine::Attributes autoScaleAttributes;
+
     QwtScaleDiv scaleDiv;
     QwtScaleEngine *scaleEngine;
     QwtScaleWidget *scaleWidget;
@@ -87,8 +159,11 @@ void QwtPlot::initAxesData()
         d.maxMinor = 5;
         d.maxMajor = 8;
 
+        d.hysteresis = false;
+        d.headroom = 0.0;
 
         d.isValid = false;
+        d.isAutoScaled = false;
     }
 
     d_axisData[yLeft]->isEnabled = true;
@@ -192,6 +267,74 @@ bool QwtPlot::axisAutoScale( int axisId ) const
         return false;
 }
 
+/*!
+  \brief Enable hysteresis for autoscaling an axis
+
+  Without hysteresis updateAxes() calculates a new scale division
+  for every replot, even if the bounding interval of the data has changed
+  by a tiny amount only. For streaming data this results in a scale,
+  whose labels and layout are recalculated for each frame.
+
+  With hysteresis the current scale division is kept as long as the data
+  remains inside of it and has not shrunk to less than half of the width,
+  that is needed for it including the headroom. When the scale has to be
+  recalculated the bounding interval of the data is extended by
+  headroom * width on both sides, so that growing data does not
+  leave the scale immediately.
+
+  \param axisId Axis index
+  \param on Enable/Disable the hysteresis
+  \param headroom Extra space in ratio to the width of the data, >= 0.0
+
+  \sa axisAutoScaleHysteresis(), axisAutoScaleHeadroom(), setAxisAutoScale()
+  \note Changes of the scale engine attributes are detected, but
+         modifications of its margins or reference value need
+         a call of setAxisScaleEngine() to become effective
+*/
+void QwtPlot::setAxisAutoScaleHysteresis( int axisId, bool on, double headroom )
+{
+    if ( axisValid( axisId ) )
+    {
+        AxisData &d = *d_axisData[axisId];
+
+        headroom = qMax( headroom, 0.0 );
+        if ( on != d.hysteresis || headroom != d.headroom )
+        {
+            d.hysteresis = on;
+            d.headroom = headroom;
+            d.isAutoScaled = false;
+
+            autoRefresh();
+        }
+    }
+}
+
+/*!
+  \return \c True, if hysteresis for autoscaling is enabled
+  \param axisId Axis index
+  \sa setAxisAutoScaleHysteresis()
+*/
+bool QwtPlot::axisAutoScaleHysteresis( int axisId ) const
+{
+    if ( axisValid( axisId ) )
+        return d_axisData[axisId]->hysteresis;
+    else
+        return false;
+}
+
+/*!
+  \return Headroom used for autoscaling with hysteresis
+  \param axisId Axis index
+  \sa setAxisAutoScaleHysteresis()
+*/
+double QwtPlot::axisAutoScaleHeadroom( int axisId ) const
+{
+    if ( axisValid( axisId ) )
+        return d_axisData[axisId]->headroom;
+    else
+        return 0.0;
+}
+
 /*!
   \return \c True, if a specified axis is enabled
   \param axisId Axis index
@@ -458,6 +601,8 @@ void QwtPlot::setAxisScale( int axisId, double min, double max, double stepSize
         d.maxValue = max;
         d.stepSize = stepSize;
 
+        QwtRenderScheduler::instance()->cancelRenders( this );
+
         autoRefresh();
     }
 }
@@ -483,6 +628,9 @@ void QwtPlot::setAxisScaleDiv( int axisId, const QwtScaleDiv &scaleDiv )
         d.doAutoScale = false;
         d.scaleDiv = scaleDiv;
         d.isValid = true;
+        d.isAutoScaled = false;
+
+        QwtRenderScheduler::instance()->cancelRenders( this );
 
         autoRefresh();
     }
@@ -680,15 +828,39 @@ void QwtPlot::updateAxes()
         double maxValue = d.maxValue;
         double stepSize = d.stepSize;
 
+        bool autoScaled = false;
+
         if ( d.doAutoScale && intv[axisId].isValid() )
         {
-            d.isValid = false;
-
-            minValue = intv[axisId].minValue();
-            maxValue = intv[axisId].maxValue();
-
-            d.scaleEngine->autoScale( d.maxMajor,
-                minValue, maxValue, stepSize );
+            const QwtTransform *transform =
+                d.scaleWidget->scaleDraw()->scaleMap().transformation();
+
+            const bool reuse = d.hysteresis && d.isValid && d.isAutoScaled
+                && d.autoScaleAttributes == d.scaleEngine->attributes()
+                && qwtIsReusable( d.scaleDiv, intv[axisId], d.headroom,
+                    transform, d.scaleEngine, d.maxMajor );
+
+            if ( !reuse )
+            {
+                d.isValid = false;
+                autoScaled = true;
+
+                minValue = intv[axisId].minValue();
+                maxValue = intv[axisId].maxValue();
+
+                if ( d.hysteresis && d.headroom > 0.0 )
+                {
+                    const double v1 = qwtTransformed( transform, minValue );
+                    const double v2 = qwtTransformed( transform, maxValue );
+                    const double dv = d.headroom * ( v2 - v1 );
+
+                    minValue = qwtInvTransformed( transform, v1 - dv );
+                    maxValue = qwtInvTransformed( transform, v2 + dv );
+                }
+
+                d.scaleEngine->autoScale( d.maxMajor,
+                    minValue, maxValue, stepSize );
+            }
         }
         if ( !d.isValid )
         {
@@ -696,6 +868,9 @@ void QwtPlot::updateAxes()
                 minValue, maxValue,
                 d.maxMajor, d.maxMinor, stepSize );
             d.isValid = true;
+
+            d.isAutoScaled = autoScaled;
+            d.autoScaleAttributes = d.scaleEngine->attributes();
         }
 
         QwtScaleWidget *scaleWidget = axisWidget( axisId );
@@ -0,0 +1,816 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_batch_renderer.h"
+#include "qwt_plot_description.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_render_scheduler.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_div.h"
+#include "qwt_scale_map.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt_painter.h"
+
+#include <qpainter.h>
+#include <qimage.h>
+#include <qimagewriter.h>
+#include <qfileinfo.h>
+#include <qmutex.h>
+#include <qhash.h>
+#include <qvector.h>
+
+#ifndef QWT_NO_SVG
+#ifdef QT_SVG_LIB
+#if QT_VERSION >= 0x040500
+#define QWT_FORMAT_SVG 1
+#endif
+#endif
+#endif
+
+#ifndef QT_NO_PDF
+// QPrinter can't be used outside of the GUI thread, so
+// we need QPdfWriter, that supports resolutions since Qt 5.3
+#if QT_VERSION >= 0x050300
+#define QWT_FORMAT_PDF 1
+#endif
+#endif
+
+#if QT_VERSION >= 0x050000
+#include <qguiapplication.h>
+#include <qscreen.h>
+#else
+#include <qapplication.h>
+#include <qdesktopwidget.h>
+#endif
+
+#if QWT_FORMAT_SVG
+#include <qsvggenerator.h>
+#endif
+
+#if QWT_FORMAT_PDF
+#include <qpdfwriter.h>
+#endif
+
+// same settings as QwtPlot/QwtScaleWidget
+static const int qwtScaleMargin = 2;
+static const int qwtScaleSpacing = 2;
+static const int qwtTitleSpacing = 2;
+
+// avoid, that the caches grow forever
+static const int qwtMaxCacheSize = 10000;
+
+static QwtScaleDraw::Alignment qwtScaleAlignment( int axisId )
+{
+    switch( axisId )
+    {
+        case QwtPlot::yLeft:
+            return QwtScaleDraw::LeftScale;
+        case QwtPlot::yRight:
+            return QwtScaleDraw::RightScale;
+        case QwtPlot::xTop:
+            return QwtScaleDraw::TopScale;
+        default:
+            return QwtScaleDraw::BottomScale;
+    }
+}
+
+static void qwtDrawAxisTitle( QPainter *painter,
+    QwtScaleDraw::Alignment align, const QRectF &rect,
+    const QwtText &title, double titleOffset )
+{
+    // see QwtScaleWidget::drawTitle()
+
+    QRectF r = rect;
+    double angle = 0.0;
+    int flags = title.renderFlags() &
+        ~( Qt::AlignTop | Qt::AlignBottom | Qt::AlignVCenter );
+
+    switch ( align )
+    {
+        case QwtScaleDraw::LeftScale:
+            angle = -90.0;
+            flags |= Qt::AlignTop;
+            r.setRect( r.left(), r.bottom(),
+                r.height(), r.width() - titleOffset );
+            break;
+
+        case QwtScaleDraw::RightScale:
+            angle = -90.0;
+            flags |= Qt::AlignTop;
+            r.setRect( r.left() + titleOffset, r.bottom(),
+                r.height(), r.width() - titleOffset );
+            break;
+
+        case QwtScaleDraw::BottomScale:
+            flags |= Qt::AlignBottom;
+            r.setTop( r.top() + titleOffset );
+            break;
+
+        case QwtScaleDraw::TopScale:
+        default:
+            flags |= Qt::AlignTop;
+            r.setBottom( r.bottom() - titleOffset );
+            break;
+    }
+
+    painter->save();
+
+    painter->translate( r.x(), r.y() );
+    if ( angle != 0.0 )
+        painter->rotate( angle );
+
+    QwtText text = title;
+    text.setRenderFlags( flags );
+    text.draw( painter, QRectF( 0.0, 0.0, r.width(), r.height() ) );
+
+    painter->restore();
+}
+
+class QwtPlotBatchRenderer::PrivateData
+{
+public:
+    PrivateData():
+        dpiX( 96 ),
+        dpiY( 96 )
+    {
+    }
+
+    double textHeight( const QwtText &text,
+        const QFont &font, double width )
+    {
+        const QString key = text.text() + QLatin1Char( '\x1f' )
+            + font.key() + QLatin1Char( '\x1f' )
+            + QString::number( text.renderFlags() ) + QLatin1Char( '\x1f' )
+            + QString::number( qwtCeil( width ) );
+
+        {
+            QMutexLocker locker( &mutex );
+
+            QHash<QString, double>::const_iterator it = textHeights.constFind( key );
+            if ( it != textHeights.constEnd() )
+                return it.value();
+        }
+
+        const double height = qwtCeil( text.heightForWidth( width, font ) );
+
+        QMutexLocker locker( &mutex );
+
+        if ( textHeights.size() >= qwtMaxCacheSize )
+            textHeights.clear();
+
+        textHeights.insert( key, height );
+
+        return height;
+    }
+
+    double scaleExtent( const QwtScaleDraw &scaleDraw, const QFont &font )
+    {
+        QString key = QString::number( scaleDraw.alignment() )
+            + QLatin1Char( '\x1f' ) + QString::number( scaleDraw.labelRotation() )
+            + QLatin1Char( '\x1f' ) + font.key();
+
+        const QList<double> ticks =
+            scaleDraw.scaleDiv().ticks( QwtScaleDiv::MajorTick );
+
+        for ( int i = 0; i < ticks.size(); i++ )
+        {
+            key += QLatin1Char( '\x1f' );
+            key += scaleDraw.label( ticks[i] ).text();
+        }
+
+        {
+            QMutexLocker locker( &mutex );
+
+            QHash<QString, double>::const_iterator it = scaleExtents.constFind( key );
+            if ( it != scaleExtents.constEnd() )
+                return it.value();
+        }
+
+        const double extent = qwtCeil( scaleDraw.extent( font ) );
+
+        QMutexLocker locker( &mutex );
+
+        if ( scaleExtents.size() >= qwtMaxCacheSize )
+            scaleExtents.clear();
+
+        scaleExtents.insert( key, extent );
+
+        return extent;
+    }
+
+    int dpiX;
+    int dpiY;
+
+    QMutex mutex;
+    QHash<QString, double> textHeights;
+    QHash<QString, double> scaleExtents;
+};
+
+class QwtBatchJobTask: public QwtRenderScheduler::Task
+{
+public:
+    virtual void renderPart( int index, int numParts ) QWT_OVERRIDE
+    {
+        Q_UNUSED( numParts )
+
+        const QVector<int> &group = groups[index];
+        for ( int i = 0; i < group.size(); i++ )
+        {
+            const int jobIndex = group[i];
+            results[jobIndex] = renderer->renderDocument( jobs->at( jobIndex ) );
+        }
+    }
+
+    const QwtPlotBatchRenderer *renderer;
+    const QList<QwtPlotBatchRenderer::Job> *jobs;
+    QVector< QVector<int> > groups;
+    QVector<bool> results;
+};
+
+static int qwtRootIndex( QVector<int> &parents, int index )
+{
+    while ( parents[index] != index )
+    {
+        parents[index] = parents[ parents[index] ];
+        index = parents[index];
+    }
+
+    return index;
+}
+
+/*
+    Jobs, whose descriptions share items, are collected
+    in the same group, as items can't be rendered concurrently
+ */
+static QVector< QVector<int> > qwtJobGroups(
+    const QList<QwtPlotBatchRenderer::Job> &jobs )
+{
+    QVector<int> parents( jobs.size() );
+    for ( int i = 0; i < parents.size(); i++ )
+        parents[i] = i;
+
+    QHash<const void *, int> owners;
+
+    for ( int i = 0; i < jobs.size(); i++ )
+    {
+        const QwtPlotDescription *description = jobs[i].description;
+        if ( description == NULL )
+            continue;
+
+        QList<const void *> objects;
+        objects += description;
+
+        const QList<const QwtPlotItem *> items = description->items();
+        for ( int j = 0; j < items.size(); j++ )
+            objects += items[j];
+
+        for ( int j = 0; j < objects.size(); j++ )
+        {
+            QHash<const void *, int>::const_iterator it =
+                owners.constFind( objects[j] );
+
+            if ( it == owners.constEnd() )
+            {
+                owners.insert( objects[j], i );
+            }
+            else
+            {
+                const int root1 = qwtRootIndex( parents, it.value() );
+                const int root2 = qwtRootIndex( parents, i );
+                parents[ qMax( root1, root2 ) ] = qMin( root1, root2 );
+            }
+        }
+    }
+
+    QVector< QVector<int> > groups;
+    QHash<int, int> groupIndexes;
+
+    for ( int i = 0; i < jobs.size(); i++ )
+    {
+        const int root = qwtRootIndex( parents, i );
+
+        QHash<int, int>::const_iterator it = groupIndexes.constFind( root );
+        if ( it == groupIndexes.constEnd() )
+        {
+            groupIndexes.insert( root, groups.size() );
+            groups += QVector<int>() << i;
+        }
+        else
+        {
+            groups[ it.value() ] += i;
+        }
+    }
+
+    return groups;
+}
+
+//! Constructor
+QwtPlotBatchRenderer::Job::Job():
+    description( NULL ),
+    sizeMM( 300, 200 ),
+    resolution( 85 )
+{
+}
+
+/*!
+  \brief Constructor
+
+  \param description Plot to be rendered
+  \param fileName Path of the file, where the document will be stored
+  \param sizeMM Size for the document in millimeters.
+  \param resolution Resolution in dots per Inch (dpi)
+ */
+QwtPlotBatchRenderer::Job::Job( const QwtPlotDescription *description,
+        const QString &fileName, const QSizeF &sizeMM, int resolution ):
+    description( description ),
+    fileName( fileName ),
+    sizeMM( sizeMM ),
+    resolution( resolution )
+{
+}
+
+/*!
+  \brief Constructor
+
+  The layout is calculated for the resolution of the primary screen.
+  Without a screen 96 dpi are used.
+
+  \sa setScreenResolution()
+ */
+QwtPlotBatchRenderer::QwtPlotBatchRenderer()
+{
+    d_data = new PrivateData;
+
+#if QT_VERSION >= 0x050000
+    if ( qobject_cast<QGuiApplication *>( QCoreApplication::instance() ) )
+    {
+        const QScreen *screen = QGuiApplication::primaryScreen();
+        if ( screen )
+        {
+            d_data->dpiX = qRound( screen->logicalDotsPerInchX() );
+            d_data->dpiY = qRound( screen->logicalDotsPerInchY() );
+        }
+    }
+#else
+    // QDesktopWidget is a widget and can't be used from other threads
+    if ( qobject_cast<const QApplication *>( QCoreApplication::instance() )
+        && QwtPainter::isGuiThread() )
+    {
+        const QWidget *desktop = QApplication::desktop();
+
+        d_data->dpiX = desktop->logicalDpiX();
+        d_data->dpiY = desktop->logicalDpiY();
+    }
+#endif
+}
+
+//! Destructor
+QwtPlotBatchRenderer::~QwtPlotBatchRenderer()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Set the screen resolution, that is used for the layout
+
+  Like QwtPlotRenderer the layout is calculated for a screen and
+  painted with a scaled painter. This method overrides the resolution
+  of the primary screen, f.e. for rendering without a GUI.
+
+  \param dpiX Horizontal resolution in dots per inch
+  \param dpiY Vertical resolution in dots per inch
+
+  \sa screenResolution()
+ */
+void QwtPlotBatchRenderer::setScreenResolution( int dpiX, int dpiY )
+{
+    if ( dpiX > 0 && dpiY > 0 )
+    {
+        d_data->dpiX = dpiX;
+        d_data->dpiY = dpiY;
+
+        clearCache();
+    }
+}
+
+/*!
+  \return Screen resolution in dots per inch, that is used for the layout
+  \sa setScreenResolution()
+ */
+QSize QwtPlotBatchRenderer::screenResolution() const
+{
+    return QSize( d_data->dpiX, d_data->dpiY );
+}
+
+/*!
+  \brief Clear the caches for text and scale sizes
+
+  The caches are shared between all jobs of the renderer
+  and are bounded in size.
+ */
+void QwtPlotBatchRenderer::clearCache()
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    d_data->textHeights.clear();
+    d_data->scaleExtents.clear();
+}
+
+/*!
+  Paint a plot into a given rectangle.
+
+  Like QwtPlotRenderer the layout is calculated in screen
+  coordinates and painted with a scaled painter.
+
+  \param description Plot to be rendered
+  \param painter Painter
+  \param plotRect Bounding rectangle
+
+  \sa renderDocument()
+ */
+void QwtPlotBatchRenderer::render( const QwtPlotDescription &description,
+    QPainter *painter, const QRectF &plotRect ) const
+{
+    if ( painter == NULL || !painter->isActive() || !plotRect.isValid() )
+        return;
+
+    const QPalette palette = description.palette();
+
+    painter->fillRect( plotRect, palette.brush( QPalette::Window ) );
+
+    QTransform transform;
+    transform.scale(
+        double( painter->device()->logicalDpiX() ) / d_data->dpiX,
+        double( painter->device()->logicalDpiY() ) / d_data->dpiY );
+
+    QRectF rect = transform.inverted().mapRect( plotRect );
+
+    // title and footer
+
+    QRectF titleRect;
+
+    const QwtText title = description.title();
+    if ( !title.isEmpty() )
+    {
+        const double h = d_data->textHeight(
+            title, description.font(), rect.width() );
+
+        titleRect.setRect( rect.x(), rect.y(), rect.width(), h );
+        rect.setTop( titleRect.bottom() + qwtTitleSpacing );
+    }
+
+    QRectF footerRect;
+
+    const QwtText footer = description.footer();
+    if ( !footer.isEmpty() )
+    {
+        const double h = d_data->textHeight(
+            footer, description.font(), rect.width() );
+
+        footerRect.setRect( rect.x(), rect.bottom() - h, rect.width(), h );
+        rect.setBottom( footerRect.top() - qwtTitleSpacing );
+    }
+
+    // scales
+
+    QwtScaleDraw scaleDraws[QwtPlot::axisCnt];
+
+    double scaleExtents[QwtPlot::axisCnt];
+    double dims[QwtPlot::axisCnt];
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        scaleExtents[axisId] = 0.0;
+        dims[axisId] = 0.0;
+
+        QwtScaleDraw &sd = scaleDraws[axisId];
+
+        sd.setAlignment( qwtScaleAlignment( axisId ) );
+        sd.setTransformation(
+            description.axisScaleEngine( axisId )->transformation() );
+        sd.setScaleDiv( description.axisScaleDiv( axisId ) );
+
+        if ( description.axisEnabled( axisId ) )
+        {
+            scaleExtents[axisId] = d_data->scaleExtent(
+                sd, description.axisFont( axisId ) );
+
+            dims[axisId] = qwtScaleMargin + scaleExtents[axisId] + 1;
+
+            const QwtText axisTitle = description.axisTitle( axisId );
+            if ( !axisTitle.isEmpty() )
+            {
+                const double length = ( sd.orientation() == Qt::Vertical )
+                    ? rect.height() : rect.width();
+
+                dims[axisId] += qwtScaleSpacing
+                    + d_data->textHeight( axisTitle, description.font(), length );
+            }
+        }
+    }
+
+    QRectF canvasRect = rect.adjusted(
+        dims[QwtPlot::yLeft], dims[QwtPlot::xTop],
+        -dims[QwtPlot::yRight], -dims[QwtPlot::xBottom] );
+
+    // the labels at the borders of the scales need some space too
+
+    double borderDists[QwtPlot::axisCnt] = { 0.0, 0.0, 0.0, 0.0 };
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        if ( !description.axisEnabled( axisId ) )
+            continue;
+
+        QwtScaleDraw &sd = scaleDraws[axisId];
+
+        int start, end;
+        if ( sd.orientation() == Qt::Vertical )
+        {
+            sd.move( 0.0, canvasRect.top() );
+            sd.setLength( canvasRect.height() );
+            sd.getBorderDistHint( description.axisFont( axisId ), start, end );
+
+            borderDists[QwtPlot::xTop] = qMax( borderDists[QwtPlot::xTop], double( start ) );
+            borderDists[QwtPlot::xBottom] = qMax( borderDists[QwtPlot::xBottom], double( end ) );
+        }
+        else
+        {
+            sd.move( canvasRect.left(), 0.0 );
+            sd.setLength( canvasRect.width() );
+            sd.getBorderDistHint( description.axisFont( axisId ), start, end );
+
+            borderDists[QwtPlot::yLeft] = qMax( borderDists[QwtPlot::yLeft], double( start ) );
+            borderDists[QwtPlot::yRight] = qMax( borderDists[QwtPlot::yRight], double( end ) );
+        }
+    }
+
+    canvasRect.setLeft( qMax( canvasRect.left(), rect.left() + borderDists[QwtPlot::yLeft] ) );
+    canvasRect.setRight( qMin( canvasRect.right(), rect.right() - borderDists[QwtPlot::yRight] ) );
+    canvasRect.setTop( qMax( canvasRect.top(), rect.top() + borderDists[QwtPlot::xTop] ) );
+    canvasRect.setBottom( qMin( canvasRect.bottom(), rect.bottom() - borderDists[QwtPlot::xBottom] ) );
+
+    if ( !canvasRect.isValid() )
+        return;
+
+    // maps and positions of the scales
+
+    QwtScaleMap maps[QwtPlot::axisCnt];
+    QRectF scaleRects[QwtPlot::axisCnt];
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        QwtScaleDraw &sd = scaleDraws[axisId];
+        const double dim = dims[axisId];
+
+        switch( axisId )
+        {
+            case QwtPlot::yLeft:
+                scaleRects[axisId].setRect( canvasRect.left() - dim,
+                    canvasRect.top(), dim, canvasRect.height() );
+                sd.move( canvasRect.left() - 1.0 - qwtScaleMargin, canvasRect.top() );
+                break;
+
+            case QwtPlot::yRight:
+                scaleRects[axisId].setRect( canvasRect.right(),
+                    canvasRect.top(), dim, canvasRect.height() );
+                sd.move( canvasRect.right() + qwtScaleMargin, canvasRect.top() );
+                break;
+
+            case QwtPlot::xTop:
+                scaleRects[axisId].setRect( canvasRect.left(),
+                    canvasRect.top() - dim, canvasRect.width(), dim );
+                sd.move( canvasRect.left(), canvasRect.top() - 1.0 - qwtScaleMargin );
+                break;
+
+            case QwtPlot::xBottom:
+            default:
+                scaleRects[axisId].setRect( canvasRect.left(),
+                    canvasRect.bottom(), canvasRect.width(), dim );
+                sd.move( canvasRect.left(), canvasRect.bottom() + qwtScaleMargin );
+                break;
+        }
+
+        sd.setLength( ( sd.orientation() == Qt::Vertical )
+            ? canvasRect.height() : canvasRect.width() );
+
+        maps[axisId] = sd.scaleMap();
+    }
+
+    // now start painting
+
+    painter->save();
+    painter->setWorldTransform( transform, true );
+
+    painter->save();
+
+    painter->fillRect( canvasRect, description.canvasBackground() );
+    painter->setClipRect( canvasRect );
+
+    const QList<const QwtPlotItem *> items = description.items();
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem *item = items[i];
+        if ( !item->isVisible() )
+            continue;
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+        item->draw( painter, maps[item->xAxis()], maps[item->yAxis()],
+            canvasRect );
+
+        painter->restore();
+    }
+
+    painter->restore();
+
+    painter->setPen( palette.color( QPalette::Text ) );
+    painter->setFont( description.font() );
+
+    if ( !title.isEmpty() )
+        title.draw( painter, titleRect );
+
+    if ( !footer.isEmpty() )
+        footer.draw( painter, footerRect );
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        if ( !description.axisEnabled( axisId ) )
+            continue;
+
+        QwtScaleDraw &sd = scaleDraws[axisId];
+
+        painter->save();
+
+        painter->setFont( description.axisFont( axisId ) );
+        sd.draw( painter, palette );
+
+        painter->restore();
+
+        const QwtText axisTitle = description.axisTitle( axisId );
+        if ( !axisTitle.isEmpty() )
+        {
+            qwtDrawAxisTitle( painter, sd.alignment(), scaleRects[axisId],
+                axisTitle, qwtScaleMargin + scaleExtents[axisId] + qwtScaleSpacing );
+        }
+    }
+
+    painter->restore();
+}
+
+/*!
+  \brief Render a plot to a file
+
+  Supported formats are:
+
+  - pdf\n
+    Portable Document Format PDF ( Qt >= 5.3 )
+  - svg\n
+    Scalable Vector Graphics SVG
+  - all image formats supported by Qt\n
+    see QImageWriter::supportedImageFormats()
+
+  \param description Plot to be rendered
+  \param fileName Path of the file, where the document will be stored
+  \param format Format for the document
+  \param sizeMM Size for the document in millimeters.
+  \param resolution Resolution in dots per Inch (dpi)
+
+  \return true, when the document has been written
+  \note This method can be called from any thread
+  \sa renderDocuments(), QwtPlotRenderer::renderDocument()
+ */
+bool QwtPlotBatchRenderer::renderDocument(
+    const QwtPlotDescription &description,
+    const QString &fileName, const QString &format,
+    const QSizeF &sizeMM, int resolution ) const
+{
+    if ( sizeMM.isEmpty() || resolution <= 0 )
+        return false;
+
+    const double mmToInch = 1.0 / 25.4;
+    const QSizeF size = sizeMM * mmToInch * resolution;
+
+    const QRectF documentRect( 0.0, 0.0, size.width(), size.height() );
+
+    QString title = description.title().text();
+    if ( title.isEmpty() )
+        title = "Plot Document";
+
+    const QString fmt = format.toLower();
+    if ( fmt == QLatin1String( "pdf" ) )
+    {
+#if QWT_FORMAT_PDF
+        QPdfWriter pdfWriter( fileName );
+        pdfWriter.setPageSizeMM( sizeMM );
+        pdfWriter.setTitle( title );
+        pdfWriter.setPageMargins( QMarginsF() );
+        pdfWriter.setResolution( resolution );
+
+        QPainter painter;
+        if ( !painter.begin( &pdfWriter ) )
+            return false;
+
+        render( description, &painter, documentRect );
+        return painter.end();
+#endif
+    }
+    else if ( fmt == QLatin1String( "svg" ) )
+    {
+#if QWT_FORMAT_SVG
+        QSvgGenerator generator;
+        generator.setTitle( title );
+        generator.setFileName( fileName );
+        generator.setResolution( resolution );
+        generator.setViewBox( documentRect );
+
+        QPainter painter;
+        if ( !painter.begin( &generator ) )
+            return false;
+
+        render( description, &painter, documentRect );
+        return painter.end();
+#endif
+    }
+    else
+    {
+        if ( QImageWriter::supportedImageFormats().indexOf(
+            fmt.toLatin1() ) >= 0 )
+        {
+            const QRect imageRect = documentRect.toRect();
+            const int dotsPerMeter = qRound( resolution * mmToInch * 1000.0 );
+
+            QImage image( imageRect.size(), QImage::Format_ARGB32 );
+            image.setDotsPerMeterX( dotsPerMeter );
+            image.setDotsPerMeterY( dotsPerMeter );
+            image.fill( QColor( Qt::white ).rgb() );
+
+            QPainter painter( &image );
+            render( description, &painter, imageRect );
+            painter.end();
+
+            return image.save( fileName, fmt.toLatin1() );
+        }
+    }
+
+    return false;
+}
+
+/*!
+  \brief Render a plot to a file
+
+  \param job Parameters of the document
+  \return true, when the document has been written
+ */
+bool QwtPlotBatchRenderer::renderDocument( const Job &job ) const
+{
+    if ( job.description == NULL )
+        return false;
+
+    QString format = job.format;
+    if ( format.isEmpty() )
+        format = QFileInfo( job.fileName ).suffix();
+
+    return renderDocument( *job.description, job.fileName,
+        format, job.sizeMM, job.resolution );
+}
+
+/*!
+  \brief Render a list of documents in parallel threads
+
+  The jobs are distributed over the threads of
+  QwtRenderScheduler and the calling thread.
+
+  Rendering a description modifies lazily calculated states of its
+  items ( f.e. bounding rectangles for autoscaling ). So jobs, whose
+  descriptions share items, are rendered one after the other
+  in the same thread.
+
+  \param jobs Documents to be rendered
+  \return Number of documents, that have been written
+  \sa QwtRenderScheduler::setMaxThreadCount()
+ */
+int QwtPlotBatchRenderer::renderDocuments( const QList<Job> &jobs ) const
+{
+    QwtBatchJobTask task;
+    task.renderer = this;
+    task.jobs = &jobs;
+    task.groups = qwtJobGroups( jobs );
+    task.results.fill( false, jobs.size() );
+
+    QwtRenderScheduler::instance()->run( NULL, &task, task.groups.size() );
+
+    return task.results.count( true );
+}
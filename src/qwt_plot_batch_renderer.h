@@ -0,0 +1,100 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_BATCH_RENDERER_H
+#define QWT_PLOT_BATCH_RENDERER_H
+
+#include "qwt_global.h"
+
+#include <qstring.h>
+#include <qsize.h>
+#include <qlist.h>
+
+class QwtPlotDescription;
+class QPainter;
+class QRectF;
+
+/*!
+  \brief Renderer for exporting plots without widgets
+
+  QwtPlotBatchRenderer renders a QwtPlotDescription to a document
+  or a QPainter. In opposite to QwtPlotRenderer no QwtPlot widget
+  needs to be created and laid out, what makes it suitable for
+  generating many documents in a row.
+
+  renderDocuments() exports a list of jobs in parallel threads
+  of QwtRenderScheduler. Sizes of texts and scales are cached by
+  the renderer, so that they are shared between the jobs.
+
+  \note When rendering in parallel the items of different descriptions
+        are drawn from different threads. Jobs, whose descriptions share
+        items, are rendered one after the other.
+
+  \sa QwtPlotRenderer, QwtPlotDescription
+*/
+class QWT_EXPORT QwtPlotBatchRenderer
+{
+public:
+    /*!
+      \brief Parameters for exporting a document
+      \sa renderDocuments()
+     */
+    class QWT_EXPORT Job
+    {
+    public:
+        Job();
+        Job( const QwtPlotDescription *, const QString &fileName,
+            const QSizeF &sizeMM, int resolution = 85 );
+
+        //! Plot to be rendered
+        const QwtPlotDescription *description;
+
+        //! Path of the file, where the document will be stored
+        QString fileName;
+
+        /*!
+          Format of the document. When empty the format
+          is derived from the suffix of fileName
+         */
+        QString format;
+
+        //! Size of the document in millimeters
+        QSizeF sizeMM;
+
+        //! Resolution in dots per inch
+        int resolution;
+    };
+
+    QwtPlotBatchRenderer();
+    virtual ~QwtPlotBatchRenderer();
+
+    virtual void render( const QwtPlotDescription &,
+        QPainter *, const QRectF &plotRect ) const;
+
+    bool renderDocument( const QwtPlotDescription &,
+        const QString &fileName, const QString &format,
+        const QSizeF &sizeMM, int resolution = 85 ) const;
+
+    bool renderDocument( const Job & ) const;
+
+    int renderDocuments( const QList<Job> & ) const;
+
+    void setScreenResolution( int dpiX, int dpiY );
+    QSize screenResolution() const;
+
+    void clearCache();
+
+private:
+    Q_DISABLE_COPY(QwtPlotBatchRenderer)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
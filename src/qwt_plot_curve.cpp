@@ -17,10 +17,16 @@
 #include "qwt_spline_curve_fitter.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
+#include "qwt_spatial_index.h"
 #include "qwt_text.h"
 #include "qwt_graphic.h"
 
 #include <qpainter.h>
+#include <qmutex.h>
+#include <qpainterpath.h>
+#include <qpaintengine.h>
+
+#include <algorithm>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *painter )
 {
@@ -38,6 +44,200 @@ static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *paint
     return clipRect;
 }
 
+static inline double qwtMappedBaseline( double baseline,
+    const QwtScaleMap &map, bool doAlign )
+{
+    if ( map.transformation() )
+        baseline = map.transformation()->bounded( baseline );
+
+    double ref = map.transform( baseline );
+    if ( doAlign )
+        ref = qRound( ref );
+
+    return ref;
+}
+
+// polygons below this size are filled by QPainter
+static const int qwtMinColumnFillPoints = 1000;
+
+static bool qwtCanFillColumns( const QPainter *painter )
+{
+    const QPaintEngine *engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::Raster )
+        return false;
+
+    if ( painter->testRenderHint( QPainter::Antialiasing ) )
+        return false;
+
+    // pixels need to be aligned to integer coordinates
+
+    const QTransform transform = painter->deviceTransform();
+    if ( transform.type() > QTransform::TxTranslate )
+        return false;
+
+    return ( transform.dx() == qRound( transform.dx() ) )
+        && ( transform.dy() == qRound( transform.dy() ) );
+}
+
+static inline double qwtPos( const QPointF &pos, bool horizontal )
+{
+    return horizontal ? pos.y() : pos.x();
+}
+
+static inline double qwtValue( const QPointF &pos, bool horizontal )
+{
+    return horizontal ? pos.x() : pos.y();
+}
+
+namespace
+{
+    class QwtColumnSpans
+    {
+    public:
+        QwtColumnSpans( bool horizontal, int size ):
+            m_horizontal( horizontal ),
+            m_column( -1 ),
+            m_from( 0 ),
+            m_to( 0 ),
+            m_numColumns( 0 )
+        {
+            m_rects.reserve( size );
+        }
+
+        inline void add( int column, int from, int to )
+        {
+            if ( m_numColumns > 0 && from == m_from && to == m_to
+                && column == m_column + m_numColumns )
+            {
+                m_numColumns++;
+                return;
+            }
+
+            flush();
+
+            m_column = column;
+            m_from = from;
+            m_to = to;
+            m_numColumns = 1;
+        }
+
+        void flush()
+        {
+            if ( m_numColumns <= 0 )
+                return;
+
+            if ( m_horizontal )
+                m_rects += QRect( m_from, m_column, m_to - m_from, m_numColumns );
+            else
+                m_rects += QRect( m_column, m_from, m_numColumns, m_to - m_from );
+
+            m_numColumns = 0;
+        }
+
+        const QVector<QRect> &rects() const
+        {
+            return m_rects;
+        }
+
+    private:
+        const bool m_horizontal;
+
+        int m_column;
+        int m_from;
+        int m_to;
+        int m_numColumns;
+
+        QVector<QRect> m_rects;
+    };
+}
+
+/*
+    Fill the area between a curve, that is monotonic in the direction
+    of its orientation, and the baseline by spans for each column of
+    pixels. Like the raster paint engine does for non antialiased
+    polygons a pixel is filled, when its center is inside.
+ */
+static bool qwtFillColumns( QPainter *painter, const QPolygonF &polygon,
+    double ref, bool horizontal, const QRectF &clipRect )
+{
+    const int numPoints = polygon.size();
+    if ( numPoints < 2 )
+        return false;
+
+    const QPointF *points = polygon.constData();
+
+    const bool increasing = qwtPos( points[numPoints - 1], horizontal )
+        >= qwtPos( points[0], horizontal );
+
+    for ( int i = 1; i < numPoints; i++ )
+    {
+        const double d = qwtPos( points[i], horizontal )
+            - qwtPos( points[i - 1], horizontal );
+
+        // also false for NaNs
+        if ( !( increasing ? ( d >= 0.0 ) : ( d <= 0.0 ) ) )
+            return false;
+    }
+
+    QPolygonF ordered;
+    if ( !increasing )
+    {
+        ordered.resize( numPoints );
+        std::reverse_copy( points, points + numPoints, ordered.begin() );
+        points = ordered.constData();
+    }
+
+    const QRect clip = clipRect.toAlignedRect();
+
+    int c1 = qwtCeil( qwtPos( points[0], horizontal ) - 0.5 );
+    int c2 = qwtCeil( qwtPos( points[numPoints - 1], horizontal ) - 0.5 ) - 1;
+
+    c1 = qMax( c1, horizontal ? clip.top() : clip.left() );
+    c2 = qMin( c2, horizontal ? clip.bottom() : clip.right() );
+
+    const int minValue = horizontal ? clip.left() : clip.top();
+    const int maxValue = ( horizontal ? clip.right() : clip.bottom() ) + 1;
+
+    QwtColumnSpans spans( horizontal, qMax( c2 - c1 + 1, 0 ) );
+
+    int k = 0;
+    for ( int c = c1; c <= c2; c++ )
+    {
+        const double pos = c + 0.5;
+
+        while ( k < numPoints - 2 && qwtPos( points[k + 1], horizontal ) <= pos )
+            k++;
+
+        const QPointF &p1 = points[k];
+        const QPointF &p2 = points[k + 1];
+
+        const double pos1 = qwtPos( p1, horizontal );
+        const double pos2 = qwtPos( p2, horizontal );
+
+        const double value1 = qwtValue( p1, horizontal );
+        const double value2 = qwtValue( p2, horizontal );
+
+        double value = value2;
+        if ( pos2 > pos1 )
+            value = value1 + ( pos - pos1 ) * ( value2 - value1 ) / ( pos2 - pos1 );
+
+        // rows with their centers between value and ref
+
+        const int from = qMax( qwtCeil( qwtMinF( value, ref ) - 0.5 ), minValue );
+        const int to = qMin( qwtCeil( qwtMaxF( value, ref ) - 0.5 ), maxValue );
+
+        if ( from < to )
+            spans.add( c, from, to );
+    }
+
+    spans.flush();
+
+    if ( !spans.rects().isEmpty() )
+        painter->drawRects( spans.rects() );
+
+    return true;
+}
+
 static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
 {
     if ( curve->symbol() &&
@@ -75,6 +275,77 @@ static int qwtVerifyRange( int size, int &i1, int &i2 )
     return ( i2 - i1 + 1 );
 }
 
+namespace
+{
+    class QwtCurveFitKey
+    {
+    public:
+        QwtCurveFitKey():
+            isValid( false )
+        {
+        }
+
+        QwtCurveFitKey( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                const QRectF &rect, int from, int to, bool filled, int mode,
+                int mapperFlags, bool clipped ):
+            isValid( true ),
+            rect( rect ),
+            from( from ),
+            to( to ),
+            filled( filled ),
+            mode( mode ),
+            mapperFlags( mapperFlags ),
+            clipped( clipped )
+        {
+            initMap( values, xMap );
+            initMap( values + 5, yMap );
+        }
+
+        bool operator==( const QwtCurveFitKey &other ) const
+        {
+            if ( !( isValid && other.isValid ) )
+                return false;
+
+            for ( int i = 0; i < 10; i++ )
+            {
+                if ( values[i] != other.values[i] )
+                    return false;
+            }
+
+            return ( rect == other.rect ) && ( from == other.from )
+                && ( to == other.to ) && ( filled == other.filled )
+                && ( mode == other.mode )
+                && ( mapperFlags == other.mapperFlags )
+                && ( clipped == other.clipped );
+        }
+
+        bool isValid;
+
+    private:
+        static void initMap( double *v, const QwtScaleMap &map )
+        {
+            v[0] = map.s1();
+            v[1] = map.s2();
+            v[2] = map.p1();
+            v[3] = map.p2();
+
+            // detecting changes of the transformation
+            v[4] = map.transform( 0.5 * ( map.s1() + map.s2() ) );
+        }
+
+        double values[10];
+        QRectF rect;
+        int from;
+        int to;
+        bool filled;
+        int mode;
+
+        // RoundPoints, WeedOutPoints ... change the polygon
+        int mapperFlags;
+        bool clipped;
+    };
+}
+
 class QwtPlotCurve::PrivateData
 {
 public:
@@ -86,7 +357,8 @@ public:
         attributes( 0 ),
         paintAttributes(
             QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints ),
-        legendAttributes( 0 )
+        legendAttributes( 0 ),
+        spatialIndexEnabled( false )
     {
         curveFitter = new QwtSplineCurveFitter;
     }
@@ -110,6 +382,59 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    // reused for the mapped points between replots
+    QMutex polylineMutex;
+    QPolygonF polylineBuffer;
+
+    // built on demand for finding points
+    bool spatialIndexEnabled;
+    QMutex indexMutex;
+    QwtSpatialIndex spatialIndex;
+
+    bool cachedFit( const QwtCurveFitKey &key,
+        QPolygonF &polygon, QPainterPath &path )
+    {
+        if ( !key.isValid )
+            return false;
+
+        QMutexLocker locker( &fitMutex );
+        if ( !( key == fitKey ) )
+            return false;
+
+        polygon = fittedPolygon;
+        path = fittedPath;
+
+        return true;
+    }
+
+    void storeFit( const QwtCurveFitKey &key,
+        const QPolygonF &polygon, const QPainterPath &path )
+    {
+        if ( !key.isValid )
+            return;
+
+        QMutexLocker locker( &fitMutex );
+
+        fitKey = key;
+        fittedPolygon = polygon;
+        fittedPath = path;
+    }
+
+    void clearFit()
+    {
+        QMutexLocker locker( &fitMutex );
+
+        fitKey = QwtCurveFitKey();
+        fittedPolygon = QPolygonF();
+        fittedPath = QPainterPath();
+    }
+
+    // result of the curve fitter from the previous replot
+    QMutex fitMutex;
+    QwtCurveFitKey fitKey;
+    QPolygonF fittedPolygon;
+    QPainterPath fittedPath;
 };
 
 /*!
@@ -169,6 +494,9 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    // all attributes might have an effect on the fitted polygon
+    d_data->clearFit();
 }
 
 /*!
@@ -537,6 +865,15 @@ void QwtPlotCurve::drawLines( QPainter *painter,
 
     mapper.setBoundingRect( canvasRect );
 
+    QwtCurveFitKey fitKey;
+    if ( doFit && ( d_data->paintAttributes & CacheFitting ) )
+    {
+        fitKey = QwtCurveFitKey( xMap, yMap, clipRect.united( canvasRect ),
+            from, to, doFill, d_data->curveFitter->mode(),
+            static_cast<int>( mapper.flags() ),
+            testPaintAttribute( ClipPolygons ) );
+    }
+
     if ( doIntegers )
     {
         QPolygon polyline = mapper.toPolygon(
@@ -551,17 +888,24 @@ void QwtPlotCurve::drawLines( QPainter *painter,
     }
     else
     {
-        QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
-
         if ( doFill )
         {
-            if ( doFit )
+            QPolygonF polyline;
+            QPainterPath curvePath;
+
+            if ( !d_data->cachedFit( fitKey, polyline, curvePath ) )
             {
-                // it might be better to extend and draw the curvePath, but for
-                // the moment we keep an implementation, where we translate the
-                // path back to a polyline.
+                polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+
+                if ( doFit )
+                {
+                    // it might be better to extend and draw the curvePath, but for
+                    // the moment we keep an implementation, where we translate the
+                    // path back to a polyline.
 
-                polyline = d_data->curveFitter->fitCurve( polyline );
+                    polyline = d_data->curveFitter->fitCurve( polyline );
+                    d_data->storeFit( fitKey, polyline, curvePath );
+                }
             }
 
             if ( painter->pen().style() != Qt::NoPen )
@@ -583,31 +927,61 @@ void QwtPlotCurve::drawLines( QPainter *painter,
                 fillCurve( painter, xMap, yMap, canvasRect, polyline );
             }
         }
-        else
+        else if ( doFit )
         {
-            if ( testPaintAttribute( ClipPolygons ) )
-            {
-                QwtClipper::clipPolygonF( clipRect, polyline, false );
-            }
+            const bool isPath =
+                d_data->curveFitter->mode() == QwtCurveFitter::Path;
 
-            if ( doFit )
+            QPolygonF fitted;
+            QPainterPath curvePath;
+
+            if ( !d_data->cachedFit( fitKey, fitted, curvePath ) )
             {
-                if ( d_data->curveFitter->mode() == QwtCurveFitter::Path )
-                {
-                    const QPainterPath curvePath =
-                        d_data->curveFitter->fitCurvePath( polyline );
+                QPolygonF polyline;
+                mapper.toPolylineF( xMap, yMap, data(), from, to,
+                    testPaintAttribute( ClipPolygons ) ? clipRect : QRectF(),
+                    polyline );
 
-                    painter->drawPath( curvePath );
-                }
+                if ( isPath )
+                    curvePath = d_data->curveFitter->fitCurvePath( polyline );
                 else
-                {
-                    polyline = d_data->curveFitter->fitCurve( polyline );
-                    QwtPainter::drawPolyline( painter, polyline );
-                }
+                    fitted = d_data->curveFitter->fitCurve( polyline );
+
+                d_data->storeFit( fitKey, fitted, curvePath );
             }
+
+            if ( isPath )
+                painter->drawPath( curvePath );
             else
+                QwtPainter::drawPolyline( painter, fitted );
+        }
+        else
+        {
+            /*
+                Mapping, weeding and clipping is done in one pass into
+                a buffer, that is reused for the next replot. When the
+                curve is painted from different threads at the same time
+                the buffer is in use and we fall back to a temporary one.
+             */
+
+            QPolygonF tmpBuffer;
+
+            const bool hasBuffer = d_data->polylineMutex.tryLock();
+            QPolygonF &polyline = hasBuffer ? d_data->polylineBuffer : tmpBuffer;
+
+            mapper.toPolylineF( xMap, yMap, data(), from, to,
+                testPaintAttribute( ClipPolygons ) ? clipRect : QRectF(),
+                polyline );
+
+            QwtPainter::drawPolyline( painter, polyline );
+
+            if ( hasBuffer )
             {
-                QwtPainter::drawPolyline( painter, polyline );
+                // don't keep the memory of huge curves forever
+                if ( polyline.capacity() > 4 * ( polyline.size() + 1024 ) )
+                    polyline = QPolygonF();
+
+                d_data->polylineMutex.unlock();
             }
         }
     }
@@ -869,6 +1243,8 @@ void QwtPlotCurve::setCurveAttribute( CurveAttribute attribute, bool on )
     else
         d_data->attributes &= ~attribute;
 
+    d_data->clearFit();
+
     itemChanged();
 }
 
@@ -881,6 +1257,20 @@ bool QwtPlotCurve::testCurveAttribute( CurveAttribute attribute ) const
     return d_data->attributes & attribute;
 }
 
+/*!
+  Discard the cached result of the curve fitter
+
+  The cache is invalidated automatically, when the samples or the
+  curve fitter are replaced. When parameters of the curve fitter
+  have been modified this method needs to be called.
+
+  \sa CacheFitting, setCurveFitter()
+*/
+void QwtPlotCurve::invalidateFitCache()
+{
+    d_data->clearFit();
+}
+
 /*!
   Assign a curve fitter
 
@@ -903,6 +1293,8 @@ void QwtPlotCurve::setCurveFitter( QwtCurveFitter *curveFitter )
     delete d_data->curveFitter;
     d_data->curveFitter = curveFitter;
 
+    d_data->clearFit();
+
     itemChanged();
 }
 
@@ -936,14 +1328,43 @@ void QwtPlotCurve::fillCurve( QPainter *painter,
     if ( d_data->brush.style() == Qt::NoBrush )
         return;
 
-    closePolyline( painter, xMap, yMap, polygon );
-    if ( polygon.count() <= 2 ) // a line can't be filled
-        return;
-
     QBrush brush = d_data->brush;
     if ( !brush.color().isValid() )
         brush.setColor( d_data->pen.color() );
 
+    if ( polygon.count() >= qwtMinColumnFillPoints && qwtCanFillColumns( painter ) )
+    {
+        /*
+            The scanline algorithm of QPainter gets slow for huge polygons.
+            As the area below a curve can be filled by one span for each
+            column of pixels we can do better.
+         */
+
+        const bool horizontal = ( orientation() == Qt::Horizontal );
+        const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+        const double ref = horizontal
+            ? qwtMappedBaseline( d_data->baseline, xMap, doAlign )
+            : qwtMappedBaseline( d_data->baseline, yMap, doAlign );
+
+        painter->save();
+
+        painter->setPen( Qt::NoPen );
+        painter->setBrush( brush );
+
+        const bool done = qwtFillColumns( painter, polygon, ref, horizontal,
+            qwtIntersectedClipRect( canvasRect, painter ) );
+
+        painter->restore();
+
+        if ( done )
+            return;
+    }
+
+    closePolyline( painter, xMap, yMap, polygon );
+    if ( polygon.count() <= 2 ) // a line can't be filled
+        return;
+
     if ( d_data->paintAttributes & ClipPolygons )
     {
         const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
@@ -978,28 +1399,18 @@ void QwtPlotCurve::closePolyline( QPainter *painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    double baseline = d_data->baseline;
+    const double baseline = d_data->baseline;
 
     if ( orientation() == Qt::Vertical )
     {
-        if ( yMap.transformation() )
-            baseline = yMap.transformation()->bounded( baseline );
-
-        double refY = yMap.transform( baseline );
-        if ( doAlign )
-            refY = qRound( refY );
+        const double refY = qwtMappedBaseline( baseline, yMap, doAlign );
 
         polygon += QPointF( polygon.last().x(), refY );
         polygon += QPointF( polygon.first().x(), refY );
     }
     else
     {
-        if ( xMap.transformation() )
-            baseline = xMap.transformation()->bounded( baseline );
-
-        double refX = xMap.transform( baseline );
-        if ( doAlign )
-            refX = qRound( refX );
+        const double refX = qwtMappedBaseline( baseline, xMap, doAlign );
 
         polygon += QPointF( refX, polygon.last().y() );
         polygon += QPointF( refX, polygon.first().y() );
@@ -1032,18 +1443,16 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
     const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
     mapper.setBoundingRect( clipRect );
 
-    const int chunkSize = 500;
+    /*
+        All points are passed in one call, so that QwtSymbol
+        stamps them into one layer, instead of allocating and
+        compositing a layer for each chunk of points
+     */
+    const QPolygonF points = mapper.toPointsF( xMap, yMap,
+        data(), from, to );
 
-    for ( int i = from; i <= to; i += chunkSize )
-    {
-        const int n = qMin( chunkSize, to - i + 1 );
-
-        const QPolygonF points = mapper.toPointsF( xMap, yMap,
-            data(), i, i + n - 1 );
-
-        if ( points.size() > 0 )
-            symbol.drawSymbols( painter, points );
-    }
+    if ( points.size() > 0 )
+        symbol.drawSymbols( painter, points );
 }
 
 /*!
@@ -1088,8 +1497,10 @@ double QwtPlotCurve::baseline() const
               the position and the closest curve point
   \return Index of the closest curve point, or -1 if none can be found
           ( f.e when the curve has no points )
-  \note closestPoint() implements a dumb algorithm, that iterates
-        over all points
+  \note Without a spatial index closestPoint() implements a dumb algorithm,
+        that iterates over all points
+
+  \sa setSpatialIndexEnabled(), pointsInRect()
 */
 int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
 {
@@ -1103,6 +1514,17 @@ int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
     const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
     const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
 
+    if ( d_data->spatialIndexEnabled )
+    {
+        QMutexLocker locker( &d_data->indexMutex );
+
+        if ( d_data->spatialIndex.dataSize() != numSamples )
+            d_data->spatialIndex.build( series );
+
+        return d_data->spatialIndex.closestPoint(
+            series, xMap, yMap, QPointF( pos ), dist );
+    }
+
     int index = -1;
     double dmin = 1.0e10;
 
@@ -1126,6 +1548,106 @@ int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
     return index;
 }
 
+/*!
+  Find all points inside of a rectangle
+
+  \param rect Rectangle in widget coordinates of the plot canvas
+  \return Sorted indexes of the points inside of rect
+
+  \sa closestPoint(), setSpatialIndexEnabled()
+*/
+QVector<int> QwtPlotCurve::pointsInRect( const QRectF &rect ) const
+{
+    const size_t numSamples = dataSize();
+
+    if ( plot() == NULL || numSamples <= 0 )
+        return QVector<int>();
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
+    const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
+
+    const QRectF dataRect =
+        QwtScaleMap::invTransform( xMap, yMap, rect ).normalized();
+
+    if ( d_data->spatialIndexEnabled )
+    {
+        QMutexLocker locker( &d_data->indexMutex );
+
+        if ( d_data->spatialIndex.dataSize() != numSamples )
+            d_data->spatialIndex.build( series );
+
+        return d_data->spatialIndex.pointsInRect( series, dataRect );
+    }
+
+    QVector<int> indexes;
+
+    for ( uint i = 0; i < numSamples; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        if ( sample.x() >= dataRect.left() && sample.x() <= dataRect.right()
+            && sample.y() >= dataRect.top() && sample.y() <= dataRect.bottom() )
+        {
+            indexes += i;
+        }
+    }
+
+    return indexes;
+}
+
+/*!
+  \brief En/Disable a spatial index for finding points
+
+  The index sorts the samples into a grid, so that closestPoint() and
+  pointsInRect() only need to check the points in the neighbourhood.
+  It is built, when it is needed for the first time and rebuilt
+  after the data has been changed. This is recommended for
+  large scatter plots, where the points are tracked by a picker.
+
+  The index is disabled by default.
+
+  \param on On/Off
+  \sa isSpatialIndexEnabled(), QwtSpatialIndex
+
+  \note When the samples are modified without replacing the series
+        dataChanged() needs to be called for updating the index.
+*/
+void QwtPlotCurve::setSpatialIndexEnabled( bool on )
+{
+    QMutexLocker locker( &d_data->indexMutex );
+
+    d_data->spatialIndexEnabled = on;
+    d_data->spatialIndex.clear();
+}
+
+/*!
+  \return True, when a spatial index is used for finding points
+  \sa setSpatialIndexEnabled()
+*/
+bool QwtPlotCurve::isSpatialIndexEnabled() const
+{
+    return d_data->spatialIndexEnabled;
+}
+
+/*!
+  Invalidate the spatial index and the cached result of the
+  curve fitter and notify the plot about the change
+  \sa setSpatialIndexEnabled()
+*/
+void QwtPlotCurve::dataChanged()
+{
+    {
+        QMutexLocker locker( &d_data->indexMutex );
+        d_data->spatialIndex.clear();
+    }
+
+    d_data->clearFit();
+
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
    \return Icon representing the curve on the legend
 
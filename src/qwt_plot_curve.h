@@ -230,6 +230,20 @@ public:
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+          Cache the result of the curve fitter for the next replot.
+
+          The cached curve is reused as long as the samples, the scale maps
+          and the geometry of the canvas have not been changed. This avoids
+          running expensive fitting algorithms for replots, that are
+          not related to the curve.
+
+          \note When modifying the curve fitter in place, the cache
+                needs to be invalidated manually.
+          \sa Fitted, invalidateFitCache()
+         */
+        CacheFitting = 0x20,
     };
 
     //! Paint attributes
@@ -273,6 +287,10 @@ public:
     void setSamples( QwtSeriesData<QPointF> * );
 
     virtual int closestPoint( const QPoint &pos, double *dist = NULL ) const;
+    QVector<int> pointsInRect( const QRectF & ) const;
+
+    void setSpatialIndexEnabled( bool );
+    bool isSpatialIndexEnabled() const;
 
     double minXValue() const;
     double maxXValue() const;
@@ -282,6 +300,8 @@ public:
     void setCurveAttribute( CurveAttribute, bool on = true );
     bool testCurveAttribute( CurveAttribute ) const;
 
+    void invalidateFitCache();
+
     void setPen( const QColor &, qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
     void setPen( const QPen & );
     const QPen &pen() const;
@@ -307,6 +327,8 @@ public:
 
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const QWT_OVERRIDE;
 
+    virtual void dataChanged() QWT_OVERRIDE;
+
 protected:
 
     void init();
@@ -0,0 +1,560 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_description.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_div.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+
+#include <qfont.h>
+#include <qbrush.h>
+#include <qpalette.h>
+#include <qalgorithms.h>
+
+static inline bool qwtAxisValid( int axisId )
+{
+    return ( axisId >= QwtPlot::yLeft ) && ( axisId < QwtPlot::axisCnt );
+}
+
+static bool qwtLessZThan( const QwtPlotItem *item1, const QwtPlotItem *item2 )
+{
+    return item1->z() < item2->z();
+}
+
+class QwtPlotDescription::PrivateData
+{
+public:
+    class AxisData
+    {
+    public:
+        bool isEnabled;
+        bool doAutoScale;
+
+        double minValue;
+        double maxValue;
+        double stepSize;
+
+        int maxMajor;
+        int maxMinor;
+
+        bool isValid;
+        QwtScaleDiv scaleDiv;
+
+        QwtScaleEngine *scaleEngine;
+
+        QwtText title;
+        QFont font;
+    };
+
+    QwtText title;
+    QwtText footer;
+    QFont font;
+    QPalette palette;
+    QBrush canvasBackground;
+
+    AxisData axisData[QwtPlot::axisCnt];
+
+    QList<const QwtPlotItem *> items;
+};
+
+/*!
+  \brief Constructor
+
+  The default fonts and sizes are the same as for QwtPlot.
+ */
+QwtPlotDescription::QwtPlotDescription()
+{
+    d_data = new PrivateData;
+
+    d_data->title.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+    d_data->footer.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+
+    d_data->font = QFont( d_data->font.family(), 14, QFont::Bold );
+    d_data->canvasBackground = QBrush( Qt::white );
+
+    const QFont scaleFont( d_data->font.family(), 10 );
+    const QFont titleFont( d_data->font.family(), 12, QFont::Bold );
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.isEnabled = ( axisId == QwtPlot::yLeft || axisId == QwtPlot::xBottom );
+        d.doAutoScale = true;
+
+        d.minValue = 0.0;
+        d.maxValue = 1000.0;
+        d.stepSize = 0.0;
+
+        d.maxMinor = 5;
+        d.maxMajor = 8;
+
+        d.isValid = false;
+
+        d.scaleEngine = new QwtLinearScaleEngine;
+
+        d.font = scaleFont;
+        d.title.setFont( titleFont );
+    }
+}
+
+//! Destructor
+QwtPlotDescription::~QwtPlotDescription()
+{
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+        delete d_data->axisData[axisId].scaleEngine;
+
+    delete d_data;
+}
+
+/*!
+  Set the title
+  \param title Title
+  \sa title()
+ */
+void QwtPlotDescription::setTitle( const QwtText &title )
+{
+    d_data->title = title;
+}
+
+/*!
+  \return Title
+  \sa setTitle()
+ */
+QwtText QwtPlotDescription::title() const
+{
+    return d_data->title;
+}
+
+/*!
+  Set the footer
+  \param footer Footer
+  \sa footer()
+ */
+void QwtPlotDescription::setFooter( const QwtText &footer )
+{
+    d_data->footer = footer;
+}
+
+/*!
+  \return Footer
+  \sa setFooter()
+ */
+QwtText QwtPlotDescription::footer() const
+{
+    return d_data->footer;
+}
+
+/*!
+  Set the font for title and footer, when the texts
+  have no font of their own
+
+  \param font Font
+  \sa font()
+ */
+void QwtPlotDescription::setFont( const QFont &font )
+{
+    d_data->font = font;
+}
+
+/*!
+  \return Font for title and footer
+  \sa setFont()
+ */
+QFont QwtPlotDescription::font() const
+{
+    return d_data->font;
+}
+
+/*!
+  Set the palette, that is used for texts, scales
+  and the background of the plot
+
+  \param palette Palette
+  \sa palette()
+ */
+void QwtPlotDescription::setPalette( const QPalette &palette )
+{
+    d_data->palette = palette;
+}
+
+/*!
+  \return Palette
+  \sa setPalette()
+ */
+QPalette QwtPlotDescription::palette() const
+{
+    return d_data->palette;
+}
+
+/*!
+  Set the background of the canvas
+  \param brush Background brush
+  \sa canvasBackground()
+ */
+void QwtPlotDescription::setCanvasBackground( const QBrush &brush )
+{
+    d_data->canvasBackground = brush;
+}
+
+/*!
+  \return Background of the canvas
+  \sa setCanvasBackground()
+ */
+QBrush QwtPlotDescription::canvasBackground() const
+{
+    return d_data->canvasBackground;
+}
+
+/*!
+  Enable or disable an axis
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisEnabled()
+ */
+void QwtPlotDescription::enableAxis( int axisId, bool on )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].isEnabled = on;
+}
+
+/*!
+  \return True, if the axis is enabled
+  \param axisId Axis index
+ */
+bool QwtPlotDescription::axisEnabled( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].isEnabled;
+
+    return false;
+}
+
+/*!
+  Set the title of an axis
+
+  \param axisId Axis index
+  \param title Title
+  \sa axisTitle()
+ */
+void QwtPlotDescription::setAxisTitle( int axisId, const QwtText &title )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].title = title;
+}
+
+/*!
+  \return Title of an axis
+  \param axisId Axis index
+ */
+QwtText QwtPlotDescription::axisTitle( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].title;
+
+    return QwtText();
+}
+
+/*!
+  Set the font for the tick labels of an axis
+
+  \param axisId Axis index
+  \param font Font
+  \sa axisFont()
+ */
+void QwtPlotDescription::setAxisFont( int axisId, const QFont &font )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].font = font;
+}
+
+/*!
+  \return Font for the tick labels of an axis
+  \param axisId Axis index
+ */
+QFont QwtPlotDescription::axisFont( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].font;
+
+    return QFont();
+}
+
+/*!
+  Change the scale engine for an axis
+
+  \param axisId Axis index
+  \param scaleEngine Scale engine, that will be deleted by the description
+  \sa axisScaleEngine()
+ */
+void QwtPlotDescription::setAxisScaleEngine(
+    int axisId, QwtScaleEngine *scaleEngine )
+{
+    if ( qwtAxisValid( axisId ) && scaleEngine != NULL )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+        if ( scaleEngine != d.scaleEngine )
+        {
+            delete d.scaleEngine;
+            d.scaleEngine = scaleEngine;
+        }
+    }
+}
+
+/*!
+  \return Scale engine of an axis
+  \param axisId Axis index
+ */
+const QwtScaleEngine *QwtPlotDescription::axisScaleEngine( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].scaleEngine;
+
+    return NULL;
+}
+
+/*!
+  Enable autoscaling for an axis
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisAutoScale(), setAxisScale()
+ */
+void QwtPlotDescription::setAxisAutoScale( int axisId, bool on )
+{
+    if ( qwtAxisValid( axisId ) )
+        d_data->axisData[axisId].doAutoScale = on;
+}
+
+/*!
+  \return True, if autoscaling is enabled
+  \param axisId Axis index
+ */
+bool QwtPlotDescription::axisAutoScale( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].doAutoScale;
+
+    return false;
+}
+
+/*!
+  \brief Disable autoscaling and specify a fixed scale for an axis
+
+  \param axisId Axis index
+  \param min Minimum of the scale
+  \param max Maximum of the scale
+  \param stepSize Major step size. If <code>step == 0</code>, the step size is
+                  calculated automatically using the maxMajor setting.
+
+  \sa QwtPlot::setAxisScale()
+ */
+void QwtPlotDescription::setAxisScale( int axisId,
+    double min, double max, double stepSize )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.doAutoScale = false;
+        d.isValid = false;
+
+        d.minValue = min;
+        d.maxValue = max;
+        d.stepSize = stepSize;
+    }
+}
+
+/*!
+  \brief Disable autoscaling and specify a fixed scale division for an axis
+
+  \param axisId Axis index
+  \param scaleDiv Scale division
+  \sa QwtPlot::setAxisScaleDiv()
+ */
+void QwtPlotDescription::setAxisScaleDiv(
+    int axisId, const QwtScaleDiv &scaleDiv )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.doAutoScale = false;
+        d.scaleDiv = scaleDiv;
+        d.isValid = true;
+    }
+}
+
+/*!
+  Set the maximum number of major scale intervals for an axis
+
+  \param axisId Axis index
+  \param maxMajor Maximum number of major steps
+  \sa axisMaxMajor()
+ */
+void QwtPlotDescription::setAxisMaxMajor( int axisId, int maxMajor )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.maxMajor = qBound( 1, maxMajor, 10000 );
+        if ( !d.doAutoScale )
+            d.isValid = false;
+    }
+}
+
+/*!
+  \return Maximum number of major ticks for an axis
+  \param axisId Axis index
+ */
+int QwtPlotDescription::axisMaxMajor( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].maxMajor;
+
+    return 0;
+}
+
+/*!
+  Set the maximum number of minor scale intervals for an axis
+
+  \param axisId Axis index
+  \param maxMinor Maximum number of minor steps
+  \sa axisMaxMinor()
+ */
+void QwtPlotDescription::setAxisMaxMinor( int axisId, int maxMinor )
+{
+    if ( qwtAxisValid( axisId ) )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.maxMinor = qBound( 0, maxMinor, 100 );
+        if ( !d.doAutoScale )
+            d.isValid = false;
+    }
+}
+
+/*!
+  \return Maximum number of minor ticks for an axis
+  \param axisId Axis index
+ */
+int QwtPlotDescription::axisMaxMinor( int axisId ) const
+{
+    if ( qwtAxisValid( axisId ) )
+        return d_data->axisData[axisId].maxMinor;
+
+    return 0;
+}
+
+/*!
+  \brief Calculate the scale division of an axis
+
+  In case of autoscaling the boundaries are calculated from
+  the bounding rectangles of all visible items, having the
+  QwtPlotItem::AutoScale flag enabled.
+
+  \param axisId Axis index
+  \return Scale division
+  \sa QwtPlot::updateAxes()
+ */
+QwtScaleDiv QwtPlotDescription::axisScaleDiv( int axisId ) const
+{
+    if ( !qwtAxisValid( axisId ) )
+        return QwtScaleDiv();
+
+    const PrivateData::AxisData &d = d_data->axisData[axisId];
+
+    if ( d.isValid && !d.doAutoScale )
+        return d.scaleDiv;
+
+    double minValue = d.minValue;
+    double maxValue = d.maxValue;
+    double stepSize = d.stepSize;
+
+    if ( d.doAutoScale )
+    {
+        QwtInterval intv;
+
+        for ( int i = 0; i < d_data->items.size(); i++ )
+        {
+            const QwtPlotItem *item = d_data->items[i];
+
+            if ( !item->testItemAttribute( QwtPlotItem::AutoScale )
+                || !item->isVisible() )
+            {
+                continue;
+            }
+
+            const QRectF rect = item->boundingRect();
+
+            if ( item->xAxis() == axisId && rect.width() >= 0.0 )
+                intv |= QwtInterval( rect.left(), rect.right() );
+
+            if ( item->yAxis() == axisId && rect.height() >= 0.0 )
+                intv |= QwtInterval( rect.top(), rect.bottom() );
+        }
+
+        if ( intv.isValid() )
+        {
+            minValue = intv.minValue();
+            maxValue = intv.maxValue();
+
+            d.scaleEngine->autoScale( d.maxMajor,
+                minValue, maxValue, stepSize );
+        }
+    }
+
+    return d.scaleEngine->divideScale( minValue, maxValue,
+        d.maxMajor, d.maxMinor, stepSize );
+}
+
+/*!
+  Add an item
+
+  \param item Plot item, that must not be attached to a plot
+  \sa removeItem(), items()
+ */
+void QwtPlotDescription::addItem( const QwtPlotItem *item )
+{
+    if ( item && !d_data->items.contains( item ) )
+        d_data->items += item;
+}
+
+/*!
+  Remove an item
+  \param item Plot item
+  \sa addItem()
+ */
+void QwtPlotDescription::removeItem( const QwtPlotItem *item )
+{
+    d_data->items.removeAll( item );
+}
+
+//! Remove all items
+void QwtPlotDescription::clearItems()
+{
+    d_data->items.clear();
+}
+
+/*!
+  \return Items sorted by their z values
+  \sa addItem()
+ */
+QList<const QwtPlotItem *> QwtPlotDescription::items() const
+{
+    QList<const QwtPlotItem *> items = d_data->items;
+    qStableSort( items.begin(), items.end(), qwtLessZThan );
+
+    return items;
+}
@@ -0,0 +1,101 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_DESCRIPTION_H
+#define QWT_PLOT_DESCRIPTION_H
+
+#include "qwt_global.h"
+#include <qlist.h>
+
+class QwtPlotItem;
+class QwtScaleEngine;
+class QwtScaleDiv;
+class QwtText;
+class QFont;
+class QBrush;
+class QPalette;
+
+/*!
+  \brief Description of a plot, that can be rendered without a widget
+
+  QwtPlotDescription holds the components of a plot - title, footer,
+  axes and plot items - like QwtPlot, but without creating any widgets.
+  It is intended for rendering plots in batch jobs, where the
+  overhead of a QwtPlot widget and its layout is not wanted.
+
+  The axes are identified by QwtPlot::Axis. Like for QwtPlot only
+  the yLeft and xBottom axes are enabled by default and their scales
+  are calculated from the bounding rectangles of the items.
+
+  \note The plot items are not owned by the description and
+        must not be attached to a QwtPlot.
+
+  \sa QwtPlotBatchRenderer
+*/
+class QWT_EXPORT QwtPlotDescription
+{
+public:
+    QwtPlotDescription();
+    virtual ~QwtPlotDescription();
+
+    void setTitle( const QwtText & );
+    QwtText title() const;
+
+    void setFooter( const QwtText & );
+    QwtText footer() const;
+
+    void setFont( const QFont & );
+    QFont font() const;
+
+    void setPalette( const QPalette & );
+    QPalette palette() const;
+
+    void setCanvasBackground( const QBrush & );
+    QBrush canvasBackground() const;
+
+    void enableAxis( int axisId, bool on = true );
+    bool axisEnabled( int axisId ) const;
+
+    void setAxisTitle( int axisId, const QwtText & );
+    QwtText axisTitle( int axisId ) const;
+
+    void setAxisFont( int axisId, const QFont & );
+    QFont axisFont( int axisId ) const;
+
+    void setAxisScaleEngine( int axisId, QwtScaleEngine * );
+    const QwtScaleEngine *axisScaleEngine( int axisId ) const;
+
+    void setAxisAutoScale( int axisId, bool on = true );
+    bool axisAutoScale( int axisId ) const;
+
+    void setAxisScale( int axisId, double min, double max, double stepSize = 0 );
+    void setAxisScaleDiv( int axisId, const QwtScaleDiv & );
+
+    void setAxisMaxMajor( int axisId, int maxMajor );
+    int axisMaxMajor( int axisId ) const;
+
+    void setAxisMaxMinor( int axisId, int maxMinor );
+    int axisMaxMinor( int axisId ) const;
+
+    QwtScaleDiv axisScaleDiv( int axisId ) const;
+
+    void addItem( const QwtPlotItem * );
+    void removeItem( const QwtPlotItem * );
+    void clearItems();
+
+    QList<const QwtPlotItem *> items() const;
+
+private:
+    Q_DISABLE_COPY(QwtPlotDescription)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
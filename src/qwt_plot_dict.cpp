@@ -9,53 +9,156 @@
 
 #include "qwt_plot_dict.h"
 
-class QwtPlotDict::PrivateData
-{
-public:
+#include <qmap.h>
+#include <qhash.h>
+#include <qmutex.h>
 
-    class ItemList: public QList<QwtPlotItem *>
+namespace
+{
+    /*
+        Items are sorted by z and in order of insertion for
+        items with the same z. As changing z reinserts the item
+        it ends up behind all other items with the same z.
+     */
+    class QwtPlotItemKey
     {
     public:
-        void insertItem( QwtPlotItem *item )
+        QwtPlotItemKey():
+            z( 0.0 ),
+            sequence( 0 )
         {
-            if ( item == NULL )
-                return;
+        }
 
-            QList<QwtPlotItem *>::iterator it =
-                qUpperBound( begin(), end(), item, LessZThan() );
-            insert( it, item );
+        QwtPlotItemKey( double zValue, quint64 seq ):
+            z( zValue ),
+            sequence( seq )
+        {
         }
 
-        void removeItem( QwtPlotItem *item )
+        inline bool operator<( const QwtPlotItemKey &other ) const
         {
-            if ( item == NULL )
-                return;
+            if ( z != other.z )
+                return z < other.z;
+
+            return sequence < other.sequence;
+        }
+
+        double z;
+        quint64 sequence;
+    };
+
+    class QwtPlotItemEntry
+    {
+    public:
+        QwtPlotItemKey key;
+
+        // rtti() is virtual and can't be called, when
+        // the item is detached from its destructor
+        int rtti;
+    };
+
+    typedef QMap<QwtPlotItemKey, QwtPlotItem *> QwtPlotItemMap;
+}
+
+class QwtPlotDict::PrivateData
+{
+public:
+    PrivateData():
+        sequence( 0 ),
+        isListValid( true ),
+        autoDelete( true )
+    {
+    }
+
+    void insertItem( QwtPlotItem *item )
+    {
+        if ( item == NULL || entries.contains( item ) )
+            return;
+
+        QwtPlotItemEntry entry;
+        entry.key = QwtPlotItemKey( item->z(), sequence++ );
+        entry.rtti = item->rtti();
+
+        entries.insert( item, entry );
+        items.insert( entry.key, item );
+        rttiItems[ entry.rtti ].insert( entry.key, item );
+
+        QMutexLocker locker( &listMutex );
 
-            QList<QwtPlotItem *>::iterator it =
-                qLowerBound( begin(), end(), item, LessZThan() );
+        if ( isListValid )
+        {
+            // attaching in increasing z order is the common case
+            // and doesn't need to rebuild the list
 
-            for ( ; it != end(); ++it )
+            if ( itemList.isEmpty() || ( --items.end() ).key().sequence
+                == entry.key.sequence )
             {
-                if ( item == *it )
-                {
-                    erase( it );
-                    break;
-                }
+                itemList += item;
             }
-        }
-    private:
-        class LessZThan
-        {
-        public:
-            inline bool operator()( const QwtPlotItem *item1,
-                const QwtPlotItem *item2 ) const
+            else
             {
-                return item1->z() < item2->z();
+                isListValid = false;
             }
-        };
-    };
+        }
+    }
+
+    void removeItem( QwtPlotItem *item )
+    {
+        if ( item == NULL )
+            return;
+
+        QHash<const QwtPlotItem *, QwtPlotItemEntry>::iterator it =
+            entries.find( item );
+        if ( it == entries.end() )
+            return;
+
+        const QwtPlotItemEntry entry = it.value();
+        entries.erase( it );
+
+        items.remove( entry.key );
+
+        QHash<int, QwtPlotItemMap>::iterator rttiIt = rttiItems.find( entry.rtti );
+        if ( rttiIt != rttiItems.end() )
+        {
+            rttiIt.value().remove( entry.key );
+            if ( rttiIt.value().isEmpty() )
+                rttiItems.erase( rttiIt );
+        }
+
+        QMutexLocker locker( &listMutex );
+
+        if ( isListValid )
+        {
+            if ( !itemList.isEmpty() && itemList.last() == item )
+                itemList.removeLast();
+            else
+                isListValid = false;
+        }
+    }
+
+    const QwtPlotItemList &list() const
+    {
+        QMutexLocker locker( &listMutex );
+
+        if ( !isListValid )
+        {
+            itemList = items.values();
+            isListValid = true;
+        }
+
+        return itemList;
+    }
+
+    QHash<const QwtPlotItem *, QwtPlotItemEntry> entries;
+    QwtPlotItemMap items;
+    QHash<int, QwtPlotItemMap> rttiItems;
+    quint64 sequence;
+
+    // the list is rebuilt from the map, when it is requested
+    mutable QMutex listMutex;
+    mutable QwtPlotItemList itemList;
+    mutable bool isListValid;
 
-    ItemList itemList;
     bool autoDelete;
 };
 
@@ -68,7 +171,6 @@ public:
 QwtPlotDict::QwtPlotDict()
 {
     d_data = new QwtPlotDict::PrivateData;
-    d_data->autoDelete = true;
 }
 
 /*!
@@ -113,7 +215,7 @@ bool QwtPlotDict::autoDelete() const
  */
 void QwtPlotDict::insertItem( QwtPlotItem *item )
 {
-    d_data->itemList.insertItem( item );
+    d_data->insertItem( item );
 }
 
 /*!
@@ -124,7 +226,7 @@ void QwtPlotDict::insertItem( QwtPlotItem *item )
  */
 void QwtPlotDict::removeItem( QwtPlotItem *item )
 {
-    d_data->itemList.removeItem( item );
+    d_data->removeItem( item );
 }
 
 /*!
@@ -136,7 +238,8 @@ void QwtPlotDict::removeItem( QwtPlotItem *item )
 */
 void QwtPlotDict::detachItems( int rtti, bool autoDelete )
 {
-    PrivateData::ItemList list = d_data->itemList;
+    const QwtPlotItemList list = itemList( rtti );
+
     QwtPlotItemIterator it = list.constBegin();
     while ( it != list.constEnd() )
     {
@@ -144,12 +247,9 @@ void QwtPlotDict::detachItems( int rtti, bool autoDelete )
 
         ++it; // increment before removing item from the list
 
-        if ( rtti == QwtPlotItem::Rtti_PlotItem || item->rtti() == rtti )
-        {
-            item->attach( NULL );
-            if ( autoDelete )
-                delete item;
-        }
+        item->attach( NULL );
+        if ( autoDelete )
+            delete item;
     }
 }
 
@@ -164,7 +264,7 @@ void QwtPlotDict::detachItems( int rtti, bool autoDelete )
 */
 const QwtPlotItemList &QwtPlotDict::itemList() const
 {
-    return d_data->itemList;
+    return d_data->list();
 }
 
 /*!
@@ -175,17 +275,7 @@ const QwtPlotItemList &QwtPlotDict::itemList() const
 QwtPlotItemList QwtPlotDict::itemList( int rtti ) const
 {
     if ( rtti == QwtPlotItem::Rtti_PlotItem )
-        return d_data->itemList;
-
-    QwtPlotItemList items;
-
-    PrivateData::ItemList list = d_data->itemList;
-    for ( QwtPlotItemIterator it = list.constBegin(); it != list.constEnd(); ++it )
-    {
-        QwtPlotItem *item = *it;
-        if ( item->rtti() == rtti )
-            items += item;
-    }
+        return d_data->list();
 
-    return items;
+    return d_data->rttiItems.value( rtti ).values();
 }
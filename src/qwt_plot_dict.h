@@ -30,6 +30,11 @@ typedef QList<QwtPlotItem *>::ConstIterator QwtPlotItemIterator;
   QwtPlotDict can be used to get access to all QwtPlotItem items - or all
   items of a specific type -  that are currently on the plot.
 
+  The items are indexed by their z value and their type, so that
+  attaching/detaching an item and itemList( int rtti ) don't need
+  to iterate over all items. Items with the same z value are kept
+  in the order of attaching them.
+
   \sa QwtPlotItem::attach(), QwtPlotItem::detach(), QwtPlotItem::z()
 */
 class QWT_EXPORT QwtPlotDict
@@ -349,6 +349,8 @@ bool QwtPlotItem::testRenderHint( RenderHint hint ) const
                      ideal thread count is used.
 
    The default thread count is 1 ( = no additional threads )
+
+   \sa ConcurrentRendering
 */
 void QwtPlotItem::setRenderThreadCount( uint numThreads )
 {
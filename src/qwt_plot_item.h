@@ -127,6 +127,9 @@ public:
         //! For QwtPlotVectorField
         Rtti_PlotVectorField,
 
+        //! For QwtPlotMarkerCollection
+        Rtti_PlotMarkerCollection,
+
         /*!
            Values >= Rtti_PlotUserItem are reserved for plot items
            not implemented in the Qwt library.
@@ -160,7 +163,20 @@ public:
            its bounding rectangle.
            \sa getCanvasMarginHint()
          */
-        Margins = 0x04
+        Margins = 0x04,
+
+        /*!
+           The item can be rendered in a worker thread into a layer
+           of its own, that is composed with the other items in z order.
+           Consecutive items with this attribute are rendered in
+           parallel on raster paint devices.
+
+           \note The implementation of draw() needs to be thread safe
+                 and must not depend on the content painted by other items.
+
+           \sa QwtPlot::drawItems(), setRenderThreadCount()
+         */
+        ConcurrentRendering = 0x08
     };
 
     //! Plot Item Attributes
@@ -18,6 +18,7 @@ class QwtPlotLayout::LayoutData
 {
 public:
     void init( const QwtPlot *, const QRectF &rect );
+    bool operator==( const LayoutData & ) const;
 
     struct t_legendData
     {
@@ -49,6 +50,7 @@ public:
         int baseLineOffset;
         double tickOffset;
         int dimWithoutTitle;
+        QwtText title;
     } scale[QwtPlot::axisCnt];
 
     struct t_canvasData
@@ -83,6 +85,13 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
 
         legend.hint = QSize( w, h );
     }
+    else
+    {
+        legend.frameWidth = 0;
+        legend.hScrollExtent = 0;
+        legend.vScrollExtent = 0;
+        legend.hint = QSize();
+    }
 
     // title
 
@@ -143,7 +152,8 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
             scale[axis].dimWithoutTitle = scaleWidget->dimForLength(
                 QWIDGETSIZE_MAX, scale[axis].scaleFont );
 
-            if ( !scaleWidget->title().isEmpty() )
+            scale[axis].title = scaleWidget->title();
+            if ( !scale[axis].title.isEmpty() )
             {
                 scale[axis].dimWithoutTitle -=
                     scaleWidget->titleHeightForWidth( QWIDGETSIZE_MAX );
@@ -152,6 +162,9 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         else
         {
             scale[axis].isEnabled = false;
+            scale[axis].scaleWidget = NULL;
+            scale[axis].scaleFont = QFont();
+            scale[axis].title = QwtText();
             scale[axis].start = 0;
             scale[axis].end = 0;
             scale[axis].baseLineOffset = 0;
@@ -169,11 +182,69 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         &canvas.contentsMargins[ QwtPlot::xBottom ] );
 }
 
+/*
+  Compare all parameters, that have an effect on the geometries
+  calculated in QwtPlotLayout::activate()
+*/
+bool QwtPlotLayout::LayoutData::operator==( const LayoutData &other ) const
+{
+    if ( legend.frameWidth != other.legend.frameWidth
+        || legend.hScrollExtent != other.legend.hScrollExtent
+        || legend.vScrollExtent != other.legend.vScrollExtent
+        || legend.hint != other.legend.hint )
+    {
+        return false;
+    }
+
+    if ( title.frameWidth != other.title.frameWidth
+        || title.text != other.title.text )
+    {
+        return false;
+    }
+
+    if ( footer.frameWidth != other.footer.frameWidth
+        || footer.text != other.footer.text )
+    {
+        return false;
+    }
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+    {
+        const t_scaleData &s1 = scale[axis];
+        const t_scaleData &s2 = other.scale[axis];
+
+        if ( s1.isEnabled != s2.isEnabled )
+            return false;
+
+        if ( s1.isEnabled )
+        {
+            if ( s1.scaleWidget != s2.scaleWidget
+                || s1.start != s2.start || s1.end != s2.end
+                || s1.baseLineOffset != s2.baseLineOffset
+                || s1.tickOffset != s2.tickOffset
+                || s1.dimWithoutTitle != s2.dimWithoutTitle
+                || s1.scaleFont != s2.scaleFont
+                || s1.title != s2.title )
+            {
+                return false;
+            }
+        }
+
+        if ( canvas.contentsMargins[axis] != other.canvas.contentsMargins[axis] )
+            return false;
+    }
+
+    return true;
+}
+
 class QwtPlotLayout::PrivateData
 {
 public:
     PrivateData():
-        spacing( 5 )
+        spacing( 5 ),
+        isCacheValid( false ),
+        legendVisible( false ),
+        layoutCount( 0 )
     {
     }
 
@@ -190,6 +261,14 @@ public:
     unsigned int spacing;
     unsigned int canvasMargin[QwtPlot::axisCnt];
     bool alignCanvasToScales[QwtPlot::axisCnt];
+
+    // inputs of the last full layout
+    bool isCacheValid;
+    QRectF cachedPlotRect;
+    QwtPlotLayout::Options cachedOptions;
+    bool legendVisible;
+
+    uint layoutCount;
 };
 
 /*!
@@ -238,6 +317,8 @@ void QwtPlotLayout::setCanvasMargin( int margin, int axis )
     }
     else if ( axis >= 0 && axis < QwtPlot::axisCnt )
         d_data->canvasMargin[axis] = margin;
+
+    d_data->isCacheValid = false;
 }
 
 /*!
@@ -263,6 +344,8 @@ void QwtPlotLayout::setAlignCanvasToScales( bool on )
 {
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->alignCanvasToScales[axis] = on;
+
+    d_data->isCacheValid = false;
 }
 
 /*!
@@ -286,6 +369,8 @@ void QwtPlotLayout::setAlignCanvasToScale( int axisId, bool on )
 {
     if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
         d_data->alignCanvasToScales[axisId] = on;
+
+    d_data->isCacheValid = false;
 }
 
 /*!
@@ -315,6 +400,7 @@ bool QwtPlotLayout::alignCanvasToScale( int axisId ) const
 void QwtPlotLayout::setSpacing( int spacing )
 {
     d_data->spacing = qMax( 0, spacing );
+    d_data->isCacheValid = false;
 }
 
 /*!
@@ -363,6 +449,8 @@ void QwtPlotLayout::setLegendPosition( QwtPlot::LegendPosition pos, double ratio
         default:
             break;
     }
+
+    d_data->isCacheValid = false;
 }
 
 /*!
@@ -535,10 +623,16 @@ QRectF QwtPlotLayout::canvasRect() const
 
 /*!
   Invalidate the geometry of all components.
-  \sa activate()
+
+  The next call of activate() will run a full layout, even
+  when the layout relevant parameters have not changed.
+
+  \sa activate(), layoutCount()
 */
 void QwtPlotLayout::invalidate()
 {
+    d_data->isCacheValid = false;
+
     d_data->titleRect = d_data->footerRect
         = d_data->legendRect = d_data->canvasRect = QRect();
 
@@ -546,6 +640,31 @@ void QwtPlotLayout::invalidate()
         d_data->scaleRect[axis] = QRect();
 }
 
+/*!
+  \return Number of full layouts, that have been calculated by activate()
+
+  activate() skips the calculation of the geometries, when none of
+  the layout relevant parameters - like the extents of the scales,
+  the sizes of the texts or the size hint of the legend - has changed
+  since the previous call. This happens f.e when autoscaling
+  results in different ranges with tick labels of the same size.
+
+  \sa resetLayoutCount(), activate(), invalidate()
+*/
+uint QwtPlotLayout::layoutCount() const
+{
+    return d_data->layoutCount;
+}
+
+/*!
+  Reset the number of full layouts to 0
+  \sa layoutCount()
+*/
+void QwtPlotLayout::resetLayoutCount()
+{
+    d_data->layoutCount = 0;
+}
+
 /*!
   \return Minimum size hint
   \param plot Plot widget
@@ -1263,23 +1382,41 @@ void QwtPlotLayout::alignScales( Options options,
   \param plotRect Rectangle where to place the components
   \param options Layout options
 
+  When none of the layout relevant parameters has changed since
+  the previous call, the geometries of the previous layout are kept.
+
   \sa invalidate(), titleRect(), footerRect()
-      legendRect(), scaleRect(), canvasRect()
+      legendRect(), scaleRect(), canvasRect(), layoutCount()
 */
 void QwtPlotLayout::activate( const QwtPlot *plot,
     const QRectF &plotRect, Options options )
 {
-    invalidate();
-
     QRectF rect( plotRect );  // undistributed rest of the plot rect
 
     // We extract all layout relevant parameters from the widgets,
-    // and save them to d_data->layoutData.
+    // and compare them with those of the previous layout. When
+    // nothing has changed the geometries are still valid.
+
+    LayoutData layoutData;
+    layoutData.init( plot, rect );
 
-    d_data->layoutData.init( plot, rect );
+    const bool legendVisible = !( options & IgnoreLegend )
+        && plot->legend() && !plot->legend()->isEmpty();
 
-    if ( !( options & IgnoreLegend )
-        && plot->legend() && !plot->legend()->isEmpty() )
+    if ( d_data->isCacheValid && d_data->cachedPlotRect == plotRect
+        && d_data->cachedOptions == options
+        && d_data->legendVisible == legendVisible
+        && d_data->layoutData == layoutData )
+    {
+        return;
+    }
+
+    invalidate();
+
+    d_data->layoutData = layoutData;
+    d_data->layoutCount++;
+
+    if ( legendVisible )
     {
         d_data->legendRect = layoutLegend( options, rect );
 
@@ -1438,4 +1575,9 @@ void QwtPlotLayout::activate( const QwtPlot *plot,
 
         d_data->legendRect = alignLegend( d_data->canvasRect, d_data->legendRect );
     }
+
+    d_data->cachedPlotRect = plotRect;
+    d_data->cachedOptions = options;
+    d_data->legendVisible = legendVisible;
+    d_data->isCacheValid = true;
 }
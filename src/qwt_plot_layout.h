@@ -85,6 +85,9 @@ public:
 
     virtual void invalidate();
 
+    uint layoutCount() const;
+    void resetLayoutCount();
+
     QRectF titleRect() const;
     QRectF footerRect() const;
     QRectF legendRect() const;
@@ -12,6 +12,7 @@
 #include "qwt_scale_map.h"
 #include "qwt_symbol.h"
 #include "qwt_text.h"
+#include "qwt_text_raster_cache.h"
 #include "qwt_graphic.h"
 #include "qwt_math.h"
 
@@ -354,8 +355,11 @@ void QwtPlotMarker::drawLabel( QPainter *painter,
     if ( d_data->labelOrientation == Qt::Vertical )
         painter->rotate( -90.0 );
 
+    // labels are drawn from rasters shared with other markers,
+    // when the paint device allows it
+
     const QRectF textRect( 0, 0, textSize.width(), textSize.height() );
-    d_data->label.draw( painter, textRect );
+    QwtTextRasterCache::instance()->draw( painter, textRect, d_data->label );
 }
 
 /*!
@@ -0,0 +1,790 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_marker_collection.h"
+#include "qwt_plot.h"
+#include "qwt_painter.h"
+#include "qwt_scale_map.h"
+#include "qwt_symbol.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include "qwt_series_data.h"
+#include "qwt_spatial_index.h"
+#include "qwt_text_raster_cache.h"
+
+#include <qpainter.h>
+#include <qmutex.h>
+#include <qnumeric.h>
+#include <qfontmetrics.h>
+
+class QwtPlotMarkerCollection::PrivateData
+{
+public:
+    PrivateData():
+        labelAlignment( Qt::AlignCenter ),
+        spacing( 2 ),
+        symbol( NULL ),
+        style( QwtPlotMarker::NoLine ),
+        maxLabelLength( 0 ),
+        maxLabelLines( 0 )
+    {
+    }
+
+    ~PrivateData()
+    {
+        delete symbol;
+    }
+
+    QVector<QString> labels;
+    QVector<QwtPlotMarker::LineStyle> styles;
+
+    QwtText labelStyle;
+    Qt::Alignment labelAlignment;
+    int spacing;
+
+    QPen pen;
+    const QwtSymbol *symbol;
+    QwtPlotMarker::LineStyle style;
+
+    QMutex indexMutex;
+    QwtSpatialIndex spatialIndex;
+
+    // characters/lines of the longest label for culling
+    int maxLabelLength;
+    int maxLabelLines;
+};
+
+/*!
+  Constructor
+  \param title Title of the item
+*/
+QwtPlotMarkerCollection::QwtPlotMarkerCollection( const QString &title ):
+    QwtPlotSeriesItem( QwtText( title ) )
+{
+    init();
+}
+
+/*!
+  Constructor
+  \param title Title of the item
+*/
+QwtPlotMarkerCollection::QwtPlotMarkerCollection( const QwtText &title ):
+    QwtPlotSeriesItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotMarkerCollection::~QwtPlotMarkerCollection()
+{
+    delete d_data;
+}
+
+//! Initialize data members
+void QwtPlotMarkerCollection::init()
+{
+    d_data = new PrivateData;
+    setData( new QwtPointSeriesData() );
+
+    setZ( 30.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotMarkerCollection
+int QwtPlotMarkerCollection::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotMarkerCollection;
+}
+
+/*!
+  Initialize the positions of the markers
+
+  \param samples Positions in plot coordinates
+  \sa setLabels(), setLineStyles()
+*/
+void QwtPlotMarkerCollection::setSamples( const QVector<QPointF> &samples )
+{
+    setData( new QwtPointSeriesData( samples ) );
+}
+
+/*!
+  Assign a series of positions
+
+  setSamples() is just a wrapper for setData() without any additional
+  value - beside that it is easier to find for the developer.
+
+  \param data Data
+  \warning The item takes ownership of the data object, deleting
+           it when its not used anymore.
+*/
+void QwtPlotMarkerCollection::setSamples( QwtSeriesData<QPointF> *data )
+{
+    setData( data );
+}
+
+/*!
+  \brief Set the texts of the labels
+
+  The label at position i belongs to the marker at position i.
+  Markers without a label or with an empty string have no label.
+
+  \param labels Texts of the labels
+  \sa labels(), setLabelStyle()
+*/
+void QwtPlotMarkerCollection::setLabels( const QVector<QString> &labels )
+{
+    d_data->labels = labels;
+
+    d_data->maxLabelLength = 0;
+    d_data->maxLabelLines = 0;
+
+    for ( int i = 0; i < labels.size(); i++ )
+    {
+        const QString &label = labels[i];
+        if ( label.isEmpty() )
+            continue;
+
+        d_data->maxLabelLength = qMax( d_data->maxLabelLength,
+            static_cast<int>( label.size() ) );
+        d_data->maxLabelLines = qMax( d_data->maxLabelLines,
+            static_cast<int>( label.count( QLatin1Char( '\n' ) ) ) + 1 );
+    }
+
+    itemChanged();
+}
+
+/*!
+  \return Texts of the labels
+  \sa setLabels()
+*/
+QVector<QString> QwtPlotMarkerCollection::labels() const
+{
+    return d_data->labels;
+}
+
+/*!
+  \brief Set the line styles of the markers
+
+  The style at position i belongs to the marker at position i.
+  Markers without an individual style are displayed with lineStyle().
+
+  \param styles Line styles
+  \sa lineStyles(), setLineStyle()
+*/
+void QwtPlotMarkerCollection::setLineStyles(
+    const QVector<QwtPlotMarker::LineStyle> &styles )
+{
+    d_data->styles = styles;
+    itemChanged();
+}
+
+/*!
+  \return Line styles of the markers
+  \sa setLineStyles()
+*/
+QVector<QwtPlotMarker::LineStyle> QwtPlotMarkerCollection::lineStyles() const
+{
+    return d_data->styles;
+}
+
+/*!
+  \brief Set the line style for markers without an individual style
+
+  \param style Line style
+  \sa lineStyle(), setLineStyles()
+*/
+void QwtPlotMarkerCollection::setLineStyle( QwtPlotMarker::LineStyle style )
+{
+    if ( style != d_data->style )
+    {
+        d_data->style = style;
+        itemChanged();
+    }
+}
+
+/*!
+  \return Line style for markers without an individual style
+  \sa setLineStyle(), setLineStyles()
+*/
+QwtPlotMarker::LineStyle QwtPlotMarkerCollection::lineStyle() const
+{
+    return d_data->style;
+}
+
+/*!
+  \param index Index of a marker
+  \return Line style, that is used for the marker
+  \sa setLineStyle(), setLineStyles()
+*/
+QwtPlotMarker::LineStyle QwtPlotMarkerCollection::lineStyle( int index ) const
+{
+    if ( index >= 0 && index < d_data->styles.size() )
+        return d_data->styles[index];
+
+    return d_data->style;
+}
+
+/*!
+  Build and assign a line pen
+
+  In Qt5 the default pen width is 1.0 ( 0.0 in Qt4 ) what makes it
+  non cosmetic ( see QPen::isCosmetic() ). This method has been introduced
+  to hide this incompatibility.
+
+  \param color Pen color
+  \param width Pen width
+  \param style Pen style
+
+  \sa linePen()
+ */
+void QwtPlotMarkerCollection::setLinePen(
+    const QColor &color, qreal width, Qt::PenStyle style )
+{
+    setLinePen( QPen( color, width, style ) );
+}
+
+/*!
+  Specify a pen for the lines of all markers
+
+  \param pen New pen
+  \sa linePen()
+*/
+void QwtPlotMarkerCollection::setLinePen( const QPen &pen )
+{
+    if ( pen != d_data->pen )
+    {
+        d_data->pen = pen;
+        itemChanged();
+    }
+}
+
+/*!
+  \return the line pen
+  \sa setLinePen()
+*/
+const QPen &QwtPlotMarkerCollection::linePen() const
+{
+    return d_data->pen;
+}
+
+/*!
+  \brief Assign a symbol, that is drawn for all markers
+
+  \param symbol New symbol
+  \sa symbol()
+*/
+void QwtPlotMarkerCollection::setSymbol( const QwtSymbol *symbol )
+{
+    if ( symbol != d_data->symbol )
+    {
+        delete d_data->symbol;
+        d_data->symbol = symbol;
+
+        itemChanged();
+    }
+}
+
+/*!
+  \return the symbol
+  \sa setSymbol(), QwtSymbol
+*/
+const QwtSymbol *QwtPlotMarkerCollection::symbol() const
+{
+    return d_data->symbol;
+}
+
+/*!
+  \brief Set the attributes of the labels
+
+  The font, color, background and render flags of the text are
+  used for all labels. Its content is replaced by the labels of the
+  markers.
+
+  \param style Text with the attributes of the labels
+  \sa labelStyle(), setLabels()
+*/
+void QwtPlotMarkerCollection::setLabelStyle( const QwtText &style )
+{
+    d_data->labelStyle = style;
+    itemChanged();
+}
+
+/*!
+  \return Text with the attributes of the labels
+  \sa setLabelStyle()
+*/
+QwtText QwtPlotMarkerCollection::labelStyle() const
+{
+    return d_data->labelStyle;
+}
+
+/*!
+  \brief Set the alignment of the labels
+
+  The alignment is interpreted like in QwtPlotMarker::setLabelAlignment().
+
+  \param align Alignment.
+  \sa labelAlignment(), QwtPlotMarker::setLabelAlignment()
+*/
+void QwtPlotMarkerCollection::setLabelAlignment( Qt::Alignment align )
+{
+    if ( align != d_data->labelAlignment )
+    {
+        d_data->labelAlignment = align;
+        itemChanged();
+    }
+}
+
+/*!
+  \return the label alignment
+  \sa setLabelAlignment()
+*/
+Qt::Alignment QwtPlotMarkerCollection::labelAlignment() const
+{
+    return d_data->labelAlignment;
+}
+
+/*!
+  \brief Set the spacing
+
+  When the label is not centered on the marker position, the spacing
+  is the distance between the position and the label.
+
+  \param spacing Spacing
+  \sa spacing(), setLabelAlignment()
+*/
+void QwtPlotMarkerCollection::setSpacing( int spacing )
+{
+    if ( spacing < 0 )
+        spacing = 0;
+
+    if ( spacing != d_data->spacing )
+    {
+        d_data->spacing = spacing;
+        itemChanged();
+    }
+}
+
+/*!
+  \return the spacing
+  \sa setSpacing()
+*/
+int QwtPlotMarkerCollection::spacing() const
+{
+    return d_data->spacing;
+}
+
+/*!
+  Find the closest marker for a specific position
+
+  \param pos Position in widget coordinates of the plot canvas
+  \param dist If dist != NULL, closestMarker() returns the distance between
+              the position and the closest marker
+  \return Index of the closest marker, or -1 if none can be found
+
+  \sa markersInRect()
+*/
+int QwtPlotMarkerCollection::closestMarker( const QPoint &pos, double *dist ) const
+{
+    const size_t numSamples = dataSize();
+
+    if ( plot() == NULL || numSamples <= 0 )
+        return -1;
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
+    const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
+
+    QMutexLocker locker( &d_data->indexMutex );
+
+    if ( d_data->spatialIndex.dataSize() != numSamples )
+        d_data->spatialIndex.build( series );
+
+    return d_data->spatialIndex.closestPoint(
+        series, xMap, yMap, QPointF( pos ), dist );
+}
+
+/*!
+  Find all markers inside of a rectangle
+
+  \param rect Rectangle in widget coordinates of the plot canvas
+  \return Sorted indexes of the markers inside of rect
+
+  \sa closestMarker()
+*/
+QVector<int> QwtPlotMarkerCollection::markersInRect( const QRectF &rect ) const
+{
+    const size_t numSamples = dataSize();
+
+    if ( plot() == NULL || numSamples <= 0 )
+        return QVector<int>();
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    const QwtScaleMap xMap = plot()->canvasMap( xAxis() );
+    const QwtScaleMap yMap = plot()->canvasMap( yAxis() );
+
+    const QRectF dataRect =
+        QwtScaleMap::invTransform( xMap, yMap, rect ).normalized();
+
+    QMutexLocker locker( &d_data->indexMutex );
+
+    if ( d_data->spatialIndex.dataSize() != numSamples )
+        d_data->spatialIndex.build( series );
+
+    return d_data->spatialIndex.pointsInRect( series, dataRect );
+}
+
+/*!
+  Invalidate the spatial index and notify the plot about the change
+  \sa closestMarker(), markersInRect()
+*/
+void QwtPlotMarkerCollection::dataChanged()
+{
+    {
+        QMutexLocker locker( &d_data->indexMutex );
+        d_data->spatialIndex.clear();
+    }
+
+    QwtPlotSeriesItem::dataChanged();
+}
+
+/*!
+  Draw a subset of the markers
+
+  Lines and symbols of all markers are collected and drawn in one
+  call, skipping everything that can't affect the canvas.
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+  \param from Index of the first marker to be painted
+  \param to Index of the last marker to be painted. If to < 0 the
+         series will be painted to its last marker.
+
+  \sa drawLabels()
+*/
+void QwtPlotMarkerCollection::drawSeries( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const int numSamples = static_cast<int>( dataSize() );
+
+    if ( !painter || numSamples <= 0 )
+        return;
+
+    if ( to < 0 )
+        to = numSamples - 1;
+
+    if ( from < 0 )
+        from = 0;
+
+    if ( from > to )
+        return;
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+    const bool doLines = d_data->pen.style() != Qt::NoPen;
+
+    const QwtSymbol *symbol = d_data->symbol;
+    const bool doSymbols = symbol && ( symbol->style() != QwtSymbol::NoSymbol );
+
+    QRectF symbolRect;
+    if ( doSymbols )
+    {
+        const QSizeF sz = symbol->size();
+        symbolRect = canvasRect.adjusted(
+            -sz.width(), -sz.height(), sz.width(), sz.height() );
+    }
+
+    QVector<QLineF> lines;
+    QPolygonF points;
+
+    // consecutive markers often end up on the same pixel,
+    // what would result in drawing the same line again
+
+    double lastX = qQNaN();
+    double lastY = qQNaN();
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        double x = xMap.transform( sample.x() );
+        double y = yMap.transform( sample.y() );
+
+        if ( doAlign )
+        {
+            x = qRound( x );
+            y = qRound( y );
+        }
+
+        const QwtPlotMarker::LineStyle style = lineStyle( i );
+
+        if ( doLines && ( style == QwtPlotMarker::HLine
+            || style == QwtPlotMarker::Cross ) )
+        {
+            if ( y >= canvasRect.top() && y <= canvasRect.bottom() && y != lastY )
+            {
+                lines += QLineF( canvasRect.left(), y, canvasRect.right() - 1.0, y );
+                lastY = y;
+            }
+        }
+
+        if ( doLines && ( style == QwtPlotMarker::VLine
+            || style == QwtPlotMarker::Cross ) )
+        {
+            if ( x >= canvasRect.left() && x <= canvasRect.right() && x != lastX )
+            {
+                lines += QLineF( x, canvasRect.top(), x, canvasRect.bottom() - 1.0 );
+                lastX = x;
+            }
+        }
+
+        if ( doSymbols && symbolRect.contains( x, y ) )
+            points += QPointF( x, y );
+    }
+
+    if ( !lines.isEmpty() )
+    {
+        painter->setPen( d_data->pen );
+        painter->drawLines( lines );
+    }
+
+    if ( !points.isEmpty() )
+        symbol->drawSymbols( painter, points );
+
+    /*
+        Like QwtPlotMarker the labels without a color of their own
+        are drawn with the line pen, whether lines are visible or not
+     */
+    painter->setPen( d_data->pen );
+
+    drawLabels( painter, xMap, yMap, canvasRect, from, to );
+}
+
+/*!
+  Draw the labels of a subset of the markers
+
+  Labels, that can't intersect the canvas, are skipped without
+  calculating their layout. All others are drawn using QwtTextRasterCache.
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+  \param from Index of the first marker to be painted
+  \param to Index of the last marker to be painted
+
+  \sa drawSeries(), labelRect()
+*/
+void QwtPlotMarkerCollection::drawLabels( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const QVector<QString> &labels = d_data->labels;
+
+    to = qMin( to, labels.size() - 1 );
+    if ( from > to )
+        return;
+
+    const QFont font = painter->font();
+
+    // no label can be further away from its marker than this
+
+    const QSizeF maxSize = maxLabelSize( font );
+
+    QSizeF symbolSize( 0.0, 0.0 );
+    if ( d_data->symbol )
+        symbolSize = d_data->symbol->size();
+
+    const qreal off = 0.5 * qwtMaxF( d_data->pen.widthF(),
+        qwtMaxF( symbolSize.width(), symbolSize.height() ) + 1 ) + d_data->spacing;
+
+    const QRectF cullRect = canvasRect.adjusted(
+        -( maxSize.width() + off ), -( maxSize.height() + off ),
+        maxSize.width() + off, maxSize.height() + off );
+
+    const QwtSeriesData<QPointF> *series = data();
+
+    QwtText text = d_data->labelStyle;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QString &label = labels[i];
+        if ( label.isEmpty() )
+            continue;
+
+        const QwtPlotMarker::LineStyle style = lineStyle( i );
+
+        const QPointF sample = series->sample( i );
+
+        // the position of labels of vertical lines depends
+        // on x only, the one of horizontal lines on y only
+
+        if ( style != QwtPlotMarker::HLine )
+        {
+            const double x = xMap.transform( sample.x() );
+            if ( x < cullRect.left() || x > cullRect.right() )
+                continue;
+        }
+
+        if ( style != QwtPlotMarker::VLine )
+        {
+            const double y = yMap.transform( sample.y() );
+            if ( y < cullRect.top() || y > cullRect.bottom() )
+                continue;
+        }
+
+        const QPointF pos = QwtScaleMap::transform( xMap, yMap, sample );
+
+        text.setText( label );
+
+        const QRectF rect = labelRect( style,
+            canvasRect, pos, text.textSize( font ) );
+
+        if ( rect.intersects( canvasRect ) )
+            QwtTextRasterCache::instance()->draw( painter, rect, text );
+    }
+}
+
+/*!
+  Calculate the geometry of a label
+
+  The label is aligned like the label of a QwtPlotMarker.
+
+  \param style Line style of the marker
+  \param canvasRect Contents rectangle of the canvas in painter coordinates
+  \param pos Position of the marker, translated into widget coordinates
+  \param textSize Size of the label
+
+  \return Rectangle of the label in painter coordinates
+  \sa QwtPlotMarker::drawLabel()
+*/
+QRectF QwtPlotMarkerCollection::labelRect( QwtPlotMarker::LineStyle style,
+    const QRectF &canvasRect, const QPointF &pos, const QSizeF &textSize ) const
+{
+    Qt::Alignment align = d_data->labelAlignment;
+    QPointF alignPos = pos;
+
+    QSizeF symbolOff( 0, 0 );
+
+    switch ( style )
+    {
+        case QwtPlotMarker::VLine:
+        {
+            // In VLine-style the y-position is pointless and
+            // the alignment flags are relative to the canvas
+
+            if ( d_data->labelAlignment & Qt::AlignTop )
+            {
+                alignPos.setY( canvasRect.top() );
+                align &= ~Qt::AlignTop;
+                align |= Qt::AlignBottom;
+            }
+            else if ( d_data->labelAlignment & Qt::AlignBottom )
+            {
+                alignPos.setY( canvasRect.bottom() - 1 );
+                align &= ~Qt::AlignBottom;
+                align |= Qt::AlignTop;
+            }
+            else
+            {
+                alignPos.setY( canvasRect.center().y() );
+            }
+            break;
+        }
+        case QwtPlotMarker::HLine:
+        {
+            // In HLine-style the x-position is pointless and
+            // the alignment flags are relative to the canvas
+
+            if ( d_data->labelAlignment & Qt::AlignLeft )
+            {
+                alignPos.setX( canvasRect.left() );
+                align &= ~Qt::AlignLeft;
+                align |= Qt::AlignRight;
+            }
+            else if ( d_data->labelAlignment & Qt::AlignRight )
+            {
+                alignPos.setX( canvasRect.right() - 1 );
+                align &= ~Qt::AlignRight;
+                align |= Qt::AlignLeft;
+            }
+            else
+            {
+                alignPos.setX( canvasRect.center().x() );
+            }
+            break;
+        }
+        default:
+        {
+            if ( d_data->symbol &&
+                ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
+            {
+                symbolOff = d_data->symbol->size() + QSizeF( 1, 1 );
+                symbolOff /= 2;
+            }
+        }
+    }
+
+    qreal pw2 = d_data->pen.widthF() / 2.0;
+    if ( pw2 == 0.0 )
+        pw2 = 0.5;
+
+    const int spacing = d_data->spacing;
+
+    const qreal xOff = qwtMaxF( pw2, symbolOff.width() );
+    const qreal yOff = qwtMaxF( pw2, symbolOff.height() );
+
+    if ( align & Qt::AlignLeft )
+        alignPos.rx() -= xOff + spacing + textSize.width();
+    else if ( align & Qt::AlignRight )
+        alignPos.rx() += xOff + spacing;
+    else
+        alignPos.rx() -= textSize.width() / 2;
+
+    if ( align & Qt::AlignTop )
+        alignPos.ry() -= yOff + spacing + textSize.height();
+    else if ( align & Qt::AlignBottom )
+        alignPos.ry() += yOff + spacing;
+    else
+        alignPos.ry() -= textSize.height() / 2;
+
+    return QRectF( alignPos, textSize );
+}
+
+/*!
+  \brief Upper bound for the size of the labels
+
+  The bound is calculated from the number of characters and lines
+  of the longest label and the metrics of the font, without laying out
+  any label. It is used for culling labels, that can't intersect
+  the canvas.
+
+  \param font Font, that is used for texts without a font
+  \return Upper bound for the size of the labels
+  \note Rich texts, that change the font size, might exceed the bound
+*/
+QSizeF QwtPlotMarkerCollection::maxLabelSize( const QFont &font ) const
+{
+    if ( d_data->maxLabelLength <= 0 )
+        return QSizeF( 0.0, 0.0 );
+
+    const QFontMetricsF fm( d_data->labelStyle.usedFont( font ) );
+
+    // one additional character/line for tabs and margins
+
+    const double w = fm.maxWidth() * ( d_data->maxLabelLength + 1 );
+    const double h = fm.lineSpacing() * ( d_data->maxLabelLines + 1 );
+
+    return QSizeF( w, h );
+}
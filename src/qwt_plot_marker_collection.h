@@ -0,0 +1,114 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_MARKER_COLLECTION_H
+#define QWT_PLOT_MARKER_COLLECTION_H
+
+#include "qwt_global.h"
+#include "qwt_plot_seriesitem.h"
+#include "qwt_plot_marker.h"
+
+#include <qvector.h>
+#include <qstring.h>
+
+class QwtSymbol;
+class QPen;
+class QColor;
+
+/*!
+  \brief A collection of markers, that are displayed by one plot item
+
+  Each QwtPlotMarker is a plot item of its own, with the overhead
+  of attaching it to the plot and of painting it individually. For
+  overlays with thousands of markers QwtPlotMarkerCollection
+  stores the positions, the line styles and the labels in arrays
+  and paints all markers in one pass:
+
+  - markers, that can't affect the canvas, are culled
+  - the lines of all markers are drawn with one call
+  - the symbols of all markers are drawn with one call
+  - the labels are drawn from QwtTextRasterCache
+
+  Pen, symbol and label attributes are shared by all markers, the line
+  style and the text of the label can be set for each marker.
+
+  closestMarker() and markersInRect() are implemented using a spatial
+  index, that is built, when it is needed for the first time.
+
+  \note Labels are always drawn horizontally.
+  \sa QwtPlotMarker, QwtSpatialIndex
+*/
+class QWT_EXPORT QwtPlotMarkerCollection:
+    public QwtPlotSeriesItem, public QwtSeriesStore<QPointF>
+{
+public:
+    explicit QwtPlotMarkerCollection( const QString &title = QString() );
+    explicit QwtPlotMarkerCollection( const QwtText &title );
+
+    virtual ~QwtPlotMarkerCollection();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setSamples( const QVector<QPointF> & );
+    void setSamples( QwtSeriesData<QPointF> * );
+
+    void setLabels( const QVector<QString> & );
+    QVector<QString> labels() const;
+
+    void setLineStyles( const QVector<QwtPlotMarker::LineStyle> & );
+    QVector<QwtPlotMarker::LineStyle> lineStyles() const;
+
+    void setLineStyle( QwtPlotMarker::LineStyle );
+    QwtPlotMarker::LineStyle lineStyle() const;
+
+    QwtPlotMarker::LineStyle lineStyle( int index ) const;
+
+    void setLinePen( const QColor &, qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
+    void setLinePen( const QPen & );
+    const QPen &linePen() const;
+
+    void setSymbol( const QwtSymbol * );
+    const QwtSymbol *symbol() const;
+
+    void setLabelStyle( const QwtText & );
+    QwtText labelStyle() const;
+
+    void setLabelAlignment( Qt::Alignment );
+    Qt::Alignment labelAlignment() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    int closestMarker( const QPoint &pos, double *dist = NULL ) const;
+    QVector<int> markersInRect( const QRectF & ) const;
+
+    virtual void drawSeries( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const QWT_OVERRIDE;
+
+protected:
+    virtual void dataChanged() QWT_OVERRIDE;
+
+    virtual void drawLabels( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const;
+
+    QRectF labelRect( QwtPlotMarker::LineStyle,
+        const QRectF &canvasRect, const QPointF &pos,
+        const QSizeF &textSize ) const;
+
+private:
+    void init();
+    QSizeF maxLabelSize( const QFont & ) const;
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
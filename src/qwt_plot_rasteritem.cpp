@@ -12,13 +12,11 @@
 #include "qwt_painter.h"
 #include "qwt_text.h"
 #include "qwt_interval.h"
+#include "qwt_render_scheduler.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
 #include <qpaintengine.h>
-#include <qthread.h>
-#include <qfuture.h>
-#include <qtconcurrentrun.h>
 
 #include <limits>
 
@@ -426,6 +424,25 @@ static void qwtToRgba( const QImage* from, QImage* to,
     }
 }
 
+class QwtRgbaTask: public QwtRenderScheduler::Task
+{
+public:
+    virtual void renderPart( int index, int numParts ) QWT_OVERRIDE
+    {
+        const int numRows = from->height() / numParts;
+
+        QRect tile( 0, index * numRows, from->width(), numRows );
+        if ( index == numParts - 1 )
+            tile.setHeight( from->height() - index * numRows );
+
+        qwtToRgba( from, to, tile, alpha );
+    }
+
+    const QImage *from;
+    QImage *to;
+    int alpha;
+};
+
 //! Constructor
 QwtPlotRasterItem::QwtPlotRasterItem( const QString& title ):
     QwtPlotItem( QwtText( title ) )
@@ -857,6 +874,12 @@ QImage QwtPlotRasterItem::compose(
 
         image = renderImage( xxMap, yyMap, imageArea, imageSize );
 
+        // a render, that has been cancelled, returns a null image
+        // and must not end up in the cache
+
+        if ( image.isNull() )
+            return image;
+
         if ( doCache )
         {
             d_data->cache.area = imageArea;
@@ -869,40 +892,20 @@ QImage QwtPlotRasterItem::compose(
     {
         QImage alphaImage( image.size(), QImage::Format_ARGB32 );
 
-#if !defined(QT_NO_QFUTURE)
-        uint numThreads = renderThreadCount();
-
-        if ( numThreads <= 0 )
-            numThreads = QThread::idealThreadCount();
+        QwtRenderScheduler *scheduler = QwtRenderScheduler::instance();
 
-        if ( numThreads <= 0 )
-            numThreads = 1;
+        QwtRgbaTask task;
+        task.from = &image;
+        task.to = &alphaImage;
+        task.alpha = d_data->alpha;
 
-        const int numRows = image.height() / numThreads;
-
-        QVector< QFuture<void> > futures;
-        futures.reserve( numThreads - 1 );
-
-        for ( uint i = 0; i < numThreads; i++ )
+        if ( !scheduler->run( this, &task,
+            scheduler->threadCount( renderThreadCount() ) ) )
         {
-            QRect tile( 0, i * numRows, image.width(), numRows );
-            if ( i == numThreads - 1 )
-            {
-                tile.setHeight( image.height() - i * numRows );
-                qwtToRgba( &image, &alphaImage, tile, d_data->alpha );
-            }
-            else
-            {
-                futures += QtConcurrent::run(
-                    &qwtToRgba, &image, &alphaImage, tile, d_data->alpha );
-            }
+            // cancelled: parts of alphaImage are uninitialized
+            return QImage();
         }
-        for ( int i = 0; i < futures.size(); i++ )
-            futures[i].waitForFinished();
-#else
-        const QRect tile( 0, 0, image.width(), image.height() );
-        qwtToRgba( &image, &alphaImage, tile, d_data->alpha );
-#endif
+
         image = alphaImage;
     }
 
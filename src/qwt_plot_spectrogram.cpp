@@ -12,14 +12,12 @@
 #include "qwt_interval.h"
 #include "qwt_scale_map.h"
 #include "qwt_color_map.h"
+#include "qwt_render_scheduler.h"
 #include "qwt_math.h"
 
 #include <qimage.h>
 #include <qpen.h>
 #include <qpainter.h>
-#include <qthread.h>
-#include <qfuture.h>
-#include <qtconcurrentrun.h>
 
 #define DEBUG_RENDER 0
 
@@ -481,42 +479,35 @@ QImage QwtPlotSpectrogram::renderImage(
     time.start();
 #endif
 
-#if !defined(QT_NO_QFUTURE)
-    uint numThreads = renderThreadCount();
+    class TileTask: public QwtRenderScheduler::Task
+    {
+    public:
+        virtual void renderPart( int index, int numParts ) QWT_OVERRIDE
+        {
+            const int numRows = image->height() / numParts;
 
-    if ( numThreads <= 0 )
-        numThreads = QThread::idealThreadCount();
+            QRect tile( 0, index * numRows, image->width(), numRows );
+            if ( index == numParts - 1 )
+                tile.setHeight( image->height() - index * numRows );
 
-    if ( numThreads <= 0 )
-        numThreads = 1;
+            spectrogram->renderTile( *xMap, *yMap, tile, image );
+        }
 
-    const int numRows = imageSize.height() / numThreads;
+        const QwtPlotSpectrogram *spectrogram;
+        const QwtScaleMap *xMap;
+        const QwtScaleMap *yMap;
+        QImage *image;
+    };
 
-    QVector< QFuture<void> > futures;
-    futures.reserve( numThreads - 1 );
+    TileTask task;
+    task.spectrogram = this;
+    task.xMap = &xMap;
+    task.yMap = &yMap;
+    task.image = &image;
 
-    for ( uint i = 0; i < numThreads; i++ )
-    {
-        QRect tile( 0, i * numRows, image.width(), numRows );
-        if ( i == numThreads - 1 )
-        {
-            tile.setHeight( image.height() - i * numRows );
-            renderTile( xMap, yMap, tile, &image );
-        }
-        else
-        {
-            futures += QtConcurrent::run(
-                this, &QwtPlotSpectrogram::renderTile,
-                xMap, yMap, tile, &image );
-        }
-    }
-    for ( int i = 0; i < futures.size(); i++ )
-        futures[i].waitForFinished();
-
-#else
-    const QRect tile( 0, 0, image.width(), image.height() );
-    renderTile( xMap, yMap, tile, &image );
-#endif
+    QwtRenderScheduler *scheduler = QwtRenderScheduler::instance();
+    const bool isComplete = scheduler->run( this, &task,
+        scheduler->threadCount( renderThreadCount() ) );
 
 #if DEBUG_RENDER
     const qint64 elapsed = time.elapsed();
@@ -525,6 +516,14 @@ QImage QwtPlotSpectrogram::renderImage(
 
     d_data->data->discardRaster();
 
+    if ( !isComplete )
+    {
+        // the render has been cancelled and tiles, that have
+        // not been started, are uninitialized
+
+        return QImage();
+    }
+
     return image;
 }
 
@@ -11,10 +11,10 @@
 #include "qwt_painter.h"
 #include "qwt_text.h"
 #include "qwt_math.h"
+#include "qwt_text_raster_cache.h"
 
 #include <qpainter.h>
-#include <qpaintengine.h>
-#include <qpixmap.h>
+#include <qimage.h>
 
 static QRect qwtItemRect( int renderFlags,
     const QRectF &rect, const QSizeF &itemSize )
@@ -61,7 +61,8 @@ public:
     QwtText text;
     int margin;
 
-    QPixmap pixmap;
+    // texts, that are too large for QwtTextRasterCache
+    QImage image;
 };
 
 /*!
@@ -185,68 +186,13 @@ void QwtPlotTextLabel::draw( QPainter *painter,
     const QRectF rect = textRect( canvasRect.adjusted( m, m, -m, -m ),
         d_data->text.textSize( painter->font() ) );
 
-    bool doCache = QwtPainter::roundingAlignment( painter );
-    if ( doCache )
-    {
-        switch( painter->paintEngine()->type() )
-        {
-            case QPaintEngine::Picture:
-            case QPaintEngine::User: // usually QwtGraphic
-            {
-                // don't use a cache for record/replay devices
-                doCache = false;
-                break;
-            }
-            default:;
-        }
-    }
+    // when the paint device is aligning it is not one
+    // where scalability matters ( PDF, SVG ).
+    // As rendering a text label is an expensive operation
+    // we use a cache.
 
-    if ( doCache )
-    {
-        // when the paint device is aligning it is not one
-        // where scalability matters ( PDF, SVG ).
-        // As rendering a text label is an expensive operation
-        // we use a cache.
-
-        int pw = 0;
-        if ( d_data->text.borderPen().style() != Qt::NoPen )
-            pw = qMax( d_data->text.borderPen().width(), 1 );
-
-        QRect pixmapRect;
-        pixmapRect.setLeft( qwtFloor( rect.left() ) - pw );
-        pixmapRect.setTop( qwtFloor( rect.top() ) - pw );
-        pixmapRect.setRight( qwtCeil( rect.right() ) + pw );
-        pixmapRect.setBottom( qwtCeil( rect.bottom() ) + pw );
-
-#if QT_VERSION >= 0x050000
-        const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
-        const QSize scaledSize = pixmapRect.size() * pixelRatio;
-#else
-        const QSize scaledSize = pixmapRect.size();
-#endif
-
-        if ( d_data->pixmap.isNull() ||
-            ( scaledSize != d_data->pixmap.size() )  )
-        {
-            d_data->pixmap = QPixmap( scaledSize );
-#if QT_VERSION >= 0x050000
-            d_data->pixmap.setDevicePixelRatio( pixelRatio );
-#endif
-            d_data->pixmap.fill( Qt::transparent );
-
-            const QRect r( pw, pw,
-                pixmapRect.width() - 2 * pw, pixmapRect.height() - 2 * pw );
-
-            QPainter pmPainter( &d_data->pixmap );
-            d_data->text.draw( &pmPainter, r );
-        }
-
-        painter->drawPixmap( pixmapRect, d_data->pixmap );
-    }
-    else
-    {
-        d_data->text.draw( painter, rect );
-    }
+    QwtTextRasterCache::instance()->draw( painter, rect,
+        d_data->text, &d_data->image );
 }
 
 /*!
@@ -269,5 +215,9 @@ QRectF QwtPlotTextLabel::textRect(
 //!  Invalidate all internal cache
 void QwtPlotTextLabel::invalidateCache()
 {
-    d_data->pixmap = QPixmap();
+    // the rasterized texts in QwtTextRasterCache are
+    // identified by their attributes, only the local image
+    // needs to be released
+
+    d_data->image = QImage();
 }
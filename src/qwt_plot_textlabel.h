@@ -24,7 +24,7 @@ class QwtText;
   plot coordinates.
 
   As drawing a text is an expensive operation the label is cached
-  in a pixmap to speed up replots.
+  in QwtTextRasterCache to speed up replots.
 
   \par Example
     The following code shows how to add a title.
@@ -13,6 +13,7 @@
 #include "qwt_global.h"
 #include "qwt_series_data.h"
 
+#include <qsharedpointer.h>
 #include <cstring>
 
 /*!
@@ -57,6 +58,80 @@ private:
     size_t d_size;
 };
 
+/*!
+  \brief Data class adopting memory blocks of T, that are owned by others
+
+  In opposite to QwtCPointerData the memory is kept alive by a shared
+  handle as long as it is referenced. When the last reference is gone
+  the deleter of the handle is called, what might be a callback
+  returning the buffer to its owner.
+
+  The values of the memory blocks might be interleaved - f.e. for
+  arrays of records - by passing the distance in bytes between
+  two values as stride. The values don't need to be aligned.
+
+  \par Example
+  \code
+#include <qwt_point_data.h>
+
+struct Record
+{
+    double time;
+    float value;
+    int flags;
+};
+
+static void releaseBuffer( void *buffer )
+{
+    // return the buffer to the acquisition
+}
+
+void AcquisitionPlot::setBuffer( Record *records, size_t count )
+{
+    const QSharedPointer<void> owner( records, releaseBuffer );
+
+    // the curve below is drawing from the records without copying
+    // them. releaseBuffer() is called, when the curve has been
+    // deleted or gets other samples.
+
+    curve->setData( new QwtSharedPointerData<double, float>(
+        owner, &records[0].time, &records[0].value, count,
+        sizeof( Record ), sizeof( Record ) ) );
+}
+  \endcode
+
+  \sa QwtCPointerData
+ */
+template <typename TX, typename TY = TX>
+class QwtSharedPointerData: public QwtPointSeriesData
+{
+public:
+    QwtSharedPointerData( const QSharedPointer<void> &owner,
+        const TX *x, const TY *y, size_t size,
+        size_t xStride = sizeof( TX ), size_t yStride = sizeof( TY ) );
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    const TX *xData() const;
+    const TY *yData() const;
+
+    size_t xStride() const;
+    size_t yStride() const;
+
+    QSharedPointer<void> owner() const;
+
+private:
+    QSharedPointer<void> d_owner;
+
+    const char *d_x;
+    const char *d_y;
+    size_t d_size;
+
+    size_t d_xStride;
+    size_t d_yStride;
+};
+
 /*!
   \brief Interface for iterating over a QVector<T>.
 
@@ -365,6 +440,96 @@ const T *QwtCPointerData<T>::yData() const
     return d_y;
 }
 
+/*!
+  Constructor
+
+  \param owner Handle keeping the memory blocks alive
+  \param x Array of x values. If NULL the index is interpreted
+           as x coordinate.
+  \param y Array of y values
+  \param size Number of values
+  \param xStride Distance in bytes between 2 x values
+  \param yStride Distance in bytes between 2 y values
+
+  \sa QwtPlotCurve::setData()
+*/
+template <typename TX, typename TY>
+QwtSharedPointerData<TX, TY>::QwtSharedPointerData(
+        const QSharedPointer<void> &owner, const TX *x, const TY *y,
+        size_t size, size_t xStride, size_t yStride ):
+    d_owner( owner ),
+    d_x( reinterpret_cast< const char * >( x ) ),
+    d_y( reinterpret_cast< const char * >( y ) ),
+    d_size( size ),
+    d_xStride( xStride ),
+    d_yStride( yStride )
+{
+}
+
+//! \return Size of the data set
+template <typename TX, typename TY>
+size_t QwtSharedPointerData<TX, TY>::size() const
+{
+    return d_size;
+}
+
+/*!
+  Return the sample at position i
+
+  \param index Index
+  \return Sample at position i
+*/
+template <typename TX, typename TY>
+QPointF QwtSharedPointerData<TX, TY>::sample( size_t index ) const
+{
+    // the values of packed records might be misaligned
+    TY y;
+    std::memcpy( &y, d_y + index * d_yStride, sizeof( TY ) );
+
+    if ( d_x == NULL )
+        return QPointF( index, y );
+
+    TX x;
+    std::memcpy( &x, d_x + index * d_xStride, sizeof( TX ) );
+
+    return QPointF( x, y );
+}
+
+//! \return Array of the x-values
+template <typename TX, typename TY>
+const TX *QwtSharedPointerData<TX, TY>::xData() const
+{
+    return reinterpret_cast< const TX * >( d_x );
+}
+
+//! \return Array of the y-values
+template <typename TX, typename TY>
+const TY *QwtSharedPointerData<TX, TY>::yData() const
+{
+    return reinterpret_cast< const TY * >( d_y );
+}
+
+//! \return Distance in bytes between 2 x values
+template <typename TX, typename TY>
+size_t QwtSharedPointerData<TX, TY>::xStride() const
+{
+    return d_xStride;
+}
+
+//! \return Distance in bytes between 2 y values
+template <typename TX, typename TY>
+size_t QwtSharedPointerData<TX, TY>::yStride() const
+{
+    return d_yStride;
+}
+
+//! \return Handle keeping the memory blocks alive
+template <typename TX, typename TY>
+QSharedPointer<void> QwtSharedPointerData<TX, TY>::owner() const
+{
+    return d_owner;
+}
+
 /*!
   Constructor
 
@@ -11,6 +11,8 @@
 #include "qwt_scale_map.h"
 #include "qwt_pixel_matrix.h"
 #include "qwt_series_data.h"
+#include "qwt_render_scheduler.h"
+#include "qwt_clipper.h"
 #include "qwt_math.h"
 
 #include <qpolygon.h>
@@ -18,14 +20,6 @@
 #include <qpen.h>
 #include <qpainter.h>
 
-#include <qthread.h>
-#include <qfuture.h>
-#include <qtconcurrentrun.h>
-
-#if !defined(QT_NO_QFUTURE)
-#define QWT_USE_THREADS 1
-#endif
-
 static QRectF qwtInvalidRect( 0.0, 0.0, -1.0, -1.0 );
 
 static inline int qwtRoundValue( double value )
@@ -278,8 +272,6 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap &xMap, const QwtScaleMap &yMa
     return polyline;
 }
 
-// Helper class to work around the 5 parameters
-// limitation of QtConcurrent::run()
 class QwtDotsCommand
 {
 public:
@@ -314,6 +306,28 @@ static void qwtRenderDots(
     }
 }
 
+class QwtDotsTask: public QwtRenderScheduler::Task
+{
+public:
+    virtual void renderPart( int index, int numParts ) QWT_OVERRIDE
+    {
+        const int numPoints = ( command.to - command.from + 1 ) / numParts;
+
+        QwtDotsCommand partCommand = command;
+        partCommand.from = command.from + index * numPoints;
+        if ( index < numParts - 1 )
+            partCommand.to = partCommand.from + numPoints - 1;
+
+        qwtRenderDots( *xMap, *yMap, partCommand, pos, image );
+    }
+
+    const QwtScaleMap *xMap;
+    const QwtScaleMap *yMap;
+    QwtDotsCommand command;
+    QPoint pos;
+    QImage *image;
+};
+
 // some functors, so that the compile can inline
 struct QwtRoundI
 {
@@ -531,6 +545,134 @@ static inline QPolygonF qwtToPointsFilteredF(
         boundingRect, xMap, yMap, series, from, to );
 }
 
+// Mapping, weeding and clipping points in one loop
+
+class QwtPolylineSink
+{
+public:
+    explicit inline QwtPolylineSink( QPolygonF &polyline ):
+        d_polyline( polyline )
+    {
+    }
+
+    inline void addPoints( const QPointF *points, int numPoints )
+    {
+        const int size = d_polyline.size();
+        d_polyline.resize( size + numPoints );
+
+        QPointF *data = d_polyline.data() + size;
+        for ( int i = 0; i < numPoints; i++ )
+            data[i] = points[i];
+    }
+
+    inline void flush()
+    {
+    }
+
+private:
+    QPolygonF &d_polyline;
+};
+
+class QwtClippedPolylineSink
+{
+public:
+    inline QwtClippedPolylineSink( const QRectF &clipRect, QPolygonF &polyline ):
+        d_clipper( clipRect, polyline, false )
+    {
+    }
+
+    inline void addPoints( const QPointF *points, int numPoints )
+    {
+        d_clipper.addPoints( points, numPoints );
+    }
+
+    inline void flush()
+    {
+        d_clipper.flush();
+    }
+
+private:
+    QwtClipper::PolygonClipperF d_clipper;
+};
+
+template<class Sink, class Round>
+static inline void qwtMapPolyline( Sink &sink,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    bool weedOut, Round round )
+{
+    // the points are passed in chunks, that fit into the cache
+    const int chunkSize = 256;
+    QPointF chunk[chunkSize];
+
+    // the coordinates are mapped in blocks, selecting the
+    // transformation only once for all values of a block
+    double xValues[chunkSize];
+    double yValues[chunkSize];
+
+    int numPoints = 0;
+
+    for ( int i = from; i <= to; i += chunkSize )
+    {
+        const int numValues = qMin( chunkSize, to - i + 1 );
+
+        for ( int j = 0; j < numValues; j++ )
+        {
+            const QPointF sample = series->sample( i + j );
+
+            xValues[j] = sample.x();
+            yValues[j] = sample.y();
+        }
+
+        xMap.transform( xValues, xValues, numValues );
+        yMap.transform( yValues, yValues, numValues );
+
+        for ( int j = 0; j < numValues; j++ )
+        {
+            const QPointF p( round( xValues[j] ), round( yValues[j] ) );
+
+            if ( weedOut && numPoints > 0 && chunk[numPoints - 1] == p )
+                continue;
+
+            if ( numPoints == chunkSize )
+            {
+                sink.addPoints( chunk, numPoints - 1 );
+
+                // keeping the last point for weeding
+                chunk[0] = chunk[numPoints - 1];
+                numPoints = 1;
+            }
+
+            chunk[numPoints++] = p;
+        }
+    }
+
+    sink.addPoints( chunk, numPoints );
+    sink.flush();
+}
+
+template<class Round>
+static inline void qwtToPolylineF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    bool weedOut, const QRectF &clipRect, QPolygonF &polyline, Round round )
+{
+    if ( clipRect.isValid() )
+    {
+        QwtClippedPolylineSink sink( clipRect, polyline );
+        qwtMapPolyline( sink, xMap, yMap, series, from, to, weedOut, round );
+    }
+    else
+    {
+        // keeping the memory of the buffer
+        polyline.resize( 0 );
+        polyline.reserve( to - from + 1 );
+
+        QwtPolylineSink sink( polyline );
+        qwtMapPolyline( sink, xMap, yMap, series, from, to, weedOut, round );
+    }
+}
+
 class QwtPointMapper::PrivateData
 {
 public:
@@ -685,6 +827,71 @@ QPolygonF QwtPointMapper::toPolygonF(
     return polyline;
 }
 
+/*!
+  \brief Translate a series of points into a clipped polyline
+
+  Mapping, weeding and clipping is done in one loop over the samples
+  without creating any temporary polygons. The result is written to
+  polyline, whose memory is reused. So passing the same buffer for
+  each replot avoids any allocations, once the buffer is large enough.
+
+  The flags are respected like in toPolygonF(). For the
+  WeedOutIntermediatePoints algorithm the points are clipped
+  in an extra pass.
+
+  \param xMap x map
+  \param yMap y map
+  \param series Series of points to be mapped
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+  \param clipRect Clip rectangle. No clipping is done for an invalid rectangle
+  \param polyline Buffer for the translated polyline
+
+  \sa toPolygonF(), QwtClipper::PolygonClipperF
+*/
+void QwtPointMapper::toPolylineF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    const QRectF &clipRect, QPolygonF &polyline ) const
+{
+    if ( from > to )
+    {
+        polyline.resize( 0 );
+        return;
+    }
+
+    const bool weedOut = d_data->flags & WeedOutPoints;
+
+    if ( d_data->flags & RoundPoints )
+    {
+        if ( d_data->flags & WeedOutIntermediatePoints )
+        {
+            const QPolygonF points = qwtMapPointsQuad<QPolygonF, QPointF>(
+                xMap, yMap, series, from, to );
+
+            if ( clipRect.isValid() )
+            {
+                QwtClipper::clipPolygonF( clipRect,
+                    points.constData(), points.size(), polyline );
+            }
+            else
+            {
+                polyline = points;
+            }
+        }
+        else
+        {
+            qwtToPolylineF( xMap, yMap, series, from, to,
+                weedOut, clipRect, polyline, QwtRoundF() );
+        }
+    }
+    else
+    {
+        qwtToPolylineF( xMap, yMap, series, from, to,
+            weedOut, clipRect, polyline, QwtNoRoundF() );
+    }
+}
+
 /*!
   \brief Translate a series of points into a QPolygon
 
@@ -887,16 +1094,6 @@ QImage QwtPointMapper::toImage(
 {
     Q_UNUSED( antialiased )
 
-#if QWT_USE_THREADS
-    if ( numThreads == 0 )
-        numThreads = QThread::idealThreadCount();
-
-    if ( numThreads <= 0 )
-        numThreads = 1;
-#else
-    Q_UNUSED( numThreads )
-#endif
-
     // a very special optimization for scatter plots
     // where every sample is mapped to one pixel only.
 
@@ -911,39 +1108,18 @@ QImage QwtPointMapper::toImage(
         command.series = series;
         command.rgb = pen.color().rgba();
 
-#if QWT_USE_THREADS
-        const int numPoints = ( to - from + 1 ) / numThreads;
-
-        QList< QFuture<void> > futures;
-        for ( uint i = 0; i < numThreads; i++ )
-        {
-            const QPoint pos = rect.topLeft();
-
-            const int index0 = from + i * numPoints;
-            if ( i == numThreads - 1 )
-            {
-                command.from = index0;
-                command.to = to;
-
-                qwtRenderDots( xMap, yMap, command, pos, &image );
-            }
-            else
-            {
-                command.from = index0;
-                command.to = index0 + numPoints - 1;
-
-                futures += QtConcurrent::run( &qwtRenderDots,
-                    xMap, yMap, command, pos, &image );
-            }
-        }
-        for ( int i = 0; i < futures.size(); i++ )
-            futures[i].waitForFinished();
-#else
         command.from = from;
         command.to = to;
 
-        qwtRenderDots( xMap, yMap, command, rect.topLeft(), &image );
-#endif
+        QwtDotsTask task;
+        task.xMap = &xMap;
+        task.yMap = &yMap;
+        task.command = command;
+        task.pos = rect.topLeft();
+        task.image = &image;
+
+        QwtRenderScheduler *scheduler = QwtRenderScheduler::instance();
+        scheduler->run( NULL, &task, scheduler->threadCount( numThreads ) );
     }
     else
     {
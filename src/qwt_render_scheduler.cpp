@@ -0,0 +1,315 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_render_scheduler.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_painter.h"
+
+#include <qapplication.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#include <qrunnable.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+#include <qatomic.h>
+#include <qsharedpointer.h>
+#include <qhash.h>
+
+namespace
+{
+    class QwtRenderJob
+    {
+    public:
+        QwtRenderJob( QwtRenderScheduler::Task *task, int numParts,
+                const QwtPlot *plot, int revision ):
+            task( task ),
+            numParts( numParts ),
+            plot( plot ),
+            revision( revision ),
+            nextPart( 0 ),
+            numDone( 0 ),
+            canceled( false )
+        {
+        }
+
+        bool isStale() const
+        {
+            return plot && QwtRenderScheduler::instance()->revision( plot ) != revision;
+        }
+
+        void process()
+        {
+            while ( true )
+            {
+                const int index = nextPart.fetchAndAddOrdered( 1 );
+                if ( index >= numParts )
+                    break;
+
+                const bool stale = isStale();
+                if ( !stale )
+                    task->renderPart( index, numParts );
+
+                QMutexLocker locker( &mutex );
+                if ( stale )
+                    canceled = true;
+
+                if ( ++numDone == numParts )
+                    finished.wakeAll();
+            }
+        }
+
+        bool waitForFinished()
+        {
+            QMutexLocker locker( &mutex );
+            while ( numDone < numParts )
+                finished.wait( &mutex );
+
+            return !canceled;
+        }
+
+        QwtRenderScheduler::Task *task;
+        const int numParts;
+
+        const QwtPlot *plot;
+        const int revision;
+
+        QAtomicInt nextPart;
+
+        QMutex mutex;
+        QWaitCondition finished;
+        int numDone;
+
+        bool canceled;
+    };
+
+    class QwtRenderRunnable: public QRunnable
+    {
+    public:
+        explicit QwtRenderRunnable( const QSharedPointer<QwtRenderJob> &job ):
+            d_job( job )
+        {
+            setAutoDelete( true );
+        }
+
+        virtual void run() QWT_OVERRIDE
+        {
+            d_job->process();
+        }
+
+    private:
+        QSharedPointer<QwtRenderJob> d_job;
+    };
+}
+
+class QwtRenderScheduler::PrivateData
+{
+public:
+    QThreadPool threadPool;
+
+    mutable QMutex mutex;
+    QHash<const QwtPlot *, int> revisions;
+};
+
+//! Destructor
+QwtRenderScheduler::Task::~Task()
+{
+}
+
+//! Constructor
+QwtRenderScheduler::QwtRenderScheduler()
+{
+    d_data = new PrivateData;
+
+    // parallel painting operations of the base library share our pool
+    QwtPainter::setThreadPool( &d_data->threadPool );
+}
+
+//! Destructor
+QwtRenderScheduler::~QwtRenderScheduler()
+{
+    if ( QwtPainter::threadPool() == &d_data->threadPool )
+        QwtPainter::setThreadPool( NULL );
+
+    d_data->threadPool.waitForDone();
+    delete d_data;
+}
+
+/*!
+  \return Scheduler, that is shared by all plots
+ */
+QwtRenderScheduler *QwtRenderScheduler::instance()
+{
+    static QwtRenderScheduler scheduler;
+    return &scheduler;
+}
+
+/*!
+  \brief Limit the number of threads of the pool
+
+  The default setting is QThread::idealThreadCount().
+
+  \param count Maximum number of worker threads
+  \sa maxThreadCount(), threadPool()
+ */
+void QwtRenderScheduler::setMaxThreadCount( int count )
+{
+    d_data->threadPool.setMaxThreadCount( qMax( count, 1 ) );
+}
+
+/*!
+  \return Maximum number of worker threads
+  \sa setMaxThreadCount()
+ */
+int QwtRenderScheduler::maxThreadCount() const
+{
+    return d_data->threadPool.maxThreadCount();
+}
+
+/*!
+  \brief Number of parts for a render
+
+  The calling thread always renders parts of its own, so the
+  result is bounded by maxThreadCount() + 1.
+
+  \param renderThreadCount Number of threads requested by a plot item.
+                           0 means the system specific ideal thread count.
+
+  \return Number of threads, that are used for a render
+  \sa QwtPlotItem::renderThreadCount()
+ */
+uint QwtRenderScheduler::threadCount( uint renderThreadCount ) const
+{
+    uint numThreads = renderThreadCount;
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads == 0 )
+        numThreads = 1;
+
+    const uint maxThreads = static_cast<uint>( maxThreadCount() ) + 1;
+    return qMin( numThreads, maxThreads );
+}
+
+/*!
+  \brief Execute a render in parallel threads
+
+  The parts are processed by the calling thread and the threads
+  of the pool. The call returns, when all parts have been processed.
+
+  \param item Item to be rendered, might be NULL
+  \param task Task, rendering the parts
+  \param numParts Number of parts
+
+  \return false, when the render has been canceled by cancelRenders()
+ */
+bool QwtRenderScheduler::run( const QwtPlotItem *item,
+    Task *task, int numParts )
+{
+    if ( task == NULL || numParts <= 0 )
+        return true;
+
+    const QwtPlot *plot = item ? item->plot() : NULL;
+
+    QSharedPointer<QwtRenderJob> job( new QwtRenderJob(
+        task, numParts, plot, revision( plot ) ) );
+
+    const int numRunnables = qMin( numParts, maxThreadCount() + 1 ) - 1;
+    if ( numRunnables > 0 )
+    {
+        const int prio = priority( plot );
+
+        for ( int i = 0; i < numRunnables; i++ )
+            d_data->threadPool.start( new QwtRenderRunnable( job ), prio );
+    }
+
+    // the calling thread takes parts too: no deadlocks for nested renders
+    job->process();
+
+    return job->waitForFinished();
+}
+
+/*!
+  \brief Cancel all renders of a plot
+
+  Parts of renders, that have not been started yet, are skipped.
+  QwtPlot calls this method, when its scales have been modified.
+
+  \param plot Plot
+  \sa revision()
+ */
+void QwtRenderScheduler::cancelRenders( const QwtPlot *plot )
+{
+    if ( plot )
+    {
+        QMutexLocker locker( &d_data->mutex );
+        d_data->revisions[plot]++;
+    }
+}
+
+/*!
+  \brief Remove all bookkeeping for a plot
+
+  \param plot Plot, that is about to be deleted
+ */
+void QwtRenderScheduler::releasePlot( const QwtPlot *plot )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->revisions.remove( plot );
+}
+
+/*!
+  \param plot Plot
+  \return Number of cancelRenders() calls for plot
+ */
+int QwtRenderScheduler::revision( const QwtPlot *plot ) const
+{
+    if ( plot == NULL )
+        return 0;
+
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->revisions.value( plot, 0 );
+}
+
+/*!
+  \brief Priority for the renders of a plot
+
+  \param plot Plot
+  \return Priority, depending on the focus and visibility of the plot
+  \note The state of the plot widget can only be evaluated from
+        its thread. Otherwise NormalPriority is returned.
+ */
+int QwtRenderScheduler::priority( const QwtPlot *plot )
+{
+    if ( plot == NULL )
+        return NormalPriority;
+
+    if ( QThread::currentThread() != plot->thread() )
+        return NormalPriority;
+
+    if ( !plot->isVisible() )
+        return LowPriority;
+
+    if ( plot->isActiveWindow() )
+    {
+        const QWidget *w = QApplication::focusWidget();
+        if ( w && ( w == plot || plot->isAncestorOf( w ) ) )
+            return HighPriority;
+    }
+
+    return NormalPriority;
+}
+
+/*!
+  \return Thread pool, that is used for rendering
+ */
+QThreadPool *QwtRenderScheduler::threadPool() const
+{
+    return &d_data->threadPool;
+}
@@ -0,0 +1,99 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_RENDER_SCHEDULER_H
+#define QWT_RENDER_SCHEDULER_H
+
+#include "qwt_global.h"
+
+class QwtPlot;
+class QwtPlotItem;
+class QThreadPool;
+
+/*!
+  \brief A scheduler for rendering plot items in parallel threads
+
+  Plot items, that split their rendering into parts ( f.e. the tiles
+  of a QwtPlotSpectrogram ) run them on a thread pool, that is shared
+  by all plots. As the number of threads of this pool is limited,
+  a matrix of plots can't oversubscribe the machine.
+
+  Parts of plots, that are focused have precedence over visible
+  plots, that have precedence over hidden plots.
+
+  Modifying the scales of a plot cancels all of its renders,
+  that are in progress: parts, that have not been started yet
+  are skipped and run() returns false.
+
+  \sa QwtPlotItem::setRenderThreadCount()
+*/
+class QWT_EXPORT QwtRenderScheduler
+{
+public:
+    //! Priority of a render
+    enum Priority
+    {
+        //! The plot is hidden
+        LowPriority = 0,
+
+        //! The plot is visible or the render is not related to a plot
+        NormalPriority = 1,
+
+        //! The plot ( or one of its children ) has the focus
+        HighPriority = 2
+    };
+
+    /*!
+      \brief Part of a render, that can be executed in parallel
+
+      The parts of a render are identified by an index
+      and have to be independent from each other.
+     */
+    class QWT_EXPORT Task
+    {
+    public:
+        virtual ~Task();
+
+        /*!
+          Render a part
+
+          \param index Index of the part
+          \param numParts Number of parts
+         */
+        virtual void renderPart( int index, int numParts ) = 0;
+    };
+
+    static QwtRenderScheduler *instance();
+
+    void setMaxThreadCount( int );
+    int maxThreadCount() const;
+
+    uint threadCount( uint renderThreadCount ) const;
+
+    bool run( const QwtPlotItem *, Task *, int numParts );
+
+    void cancelRenders( const QwtPlot * );
+    void releasePlot( const QwtPlot * );
+
+    int revision( const QwtPlot * ) const;
+    static int priority( const QwtPlot * );
+
+    QThreadPool *threadPool() const;
+
+private:
+    QwtRenderScheduler();
+    ~QwtRenderScheduler();
+
+    Q_DISABLE_COPY(QwtRenderScheduler)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -14,9 +14,217 @@
 #include "qwt_painter.h"
 #include "qwt_text.h"
 
+#include "qwt_text_engine.h"
+
 #include <qpainter.h>
 #include <qpaintengine.h>
 #include <qmath.h>
+#include <qapplication.h>
+#include <qdesktopwidget.h>
+#include <qmutex.h>
+#include <qcache.h>
+#if QT_VERSION >= 0x040700
+#include <qstatictext.h>
+#endif
+
+namespace
+{
+    /*
+        Tick labels are formatted and measured again, whenever the scale
+        div changes. As most labels reappear after panning or zooming
+        the layouts are shared by all scale draws in a cache, that is
+        indexed by the text and the font.
+     */
+    class QwtLabelLayout
+    {
+    public:
+        QwtLabelLayout():
+            isPrepared( false )
+        {
+        }
+
+        QSizeF size;
+
+        // position of the text relative to the label rectangle
+        QPointF offset;
+
+        bool isPrepared;
+#if QT_VERSION >= 0x040700
+        QStaticText staticText;
+#endif
+    };
+
+    class QwtLabelLayoutCache
+    {
+    public:
+        enum
+        {
+            MaxLayouts = 2000
+        };
+
+        static QwtLabelLayoutCache *instance()
+        {
+            static QwtLabelLayoutCache cache;
+            return &cache;
+        }
+
+        bool find( const QString &key, QwtLabelLayout &layout )
+        {
+            QMutexLocker locker( &d_mutex );
+
+            const QwtLabelLayout *cachedLayout = d_layouts.object( key );
+            if ( cachedLayout == NULL )
+                return false;
+
+            layout = *cachedLayout;
+            return true;
+        }
+
+        void insert( const QString &key, const QwtLabelLayout &layout )
+        {
+            QMutexLocker locker( &d_mutex );
+            d_layouts.insert( key, new QwtLabelLayout( layout ) );
+        }
+
+    private:
+        QwtLabelLayoutCache():
+            d_layouts( MaxLayouts )
+        {
+        }
+
+        QMutex d_mutex;
+        QCache<QString, QwtLabelLayout> d_layouts;
+    };
+}
+
+static inline bool qwtIsPlainLabel( const QwtText &label )
+{
+    if ( label.testPaintAttribute( QwtText::PaintBackground ) )
+        return false;
+
+    const QString text = label.text();
+    if ( text.contains( QLatin1Char( '\n' ) ) )
+        return false;
+
+    return QwtText::textEngine( text ) == QwtText::textEngine( QwtText::PlainText );
+}
+
+static inline QString qwtLabelKey( const QwtText &label, const QFont &font )
+{
+    QString key = label.text();
+    key += QChar( 0 );
+    key += label.usedFont( font ).key();
+    key += QChar( 0 );
+    key += QString::number( label.renderFlags() );
+    key += label.testLayoutAttribute( QwtText::MinimumLayout )
+        ? QLatin1Char( 'm' ) : QLatin1Char( 'n' );
+
+    return key;
+}
+
+static bool qwtLabelLayout( const QwtText &label,
+    const QFont &font, QwtLabelLayout &layout )
+{
+    if ( !qwtIsPlainLabel( label ) )
+        return false;
+
+    const QString key = qwtLabelKey( label, font );
+
+    QwtLabelLayoutCache *cache = QwtLabelLayoutCache::instance();
+    if ( !cache->find( key, layout ) )
+    {
+        layout = QwtLabelLayout();
+        layout.size = label.textSize( font );
+
+        if ( label.testLayoutAttribute( QwtText::MinimumLayout ) )
+        {
+            const QFont screenFont = QwtPainter::screenFont( label.usedFont( font ) );
+
+            double left, right, top, bottom;
+            QwtText::textEngine( QwtText::PlainText )->textMargins(
+                screenFont, label.text(), left, right, top, bottom );
+
+            layout.offset = QPointF( -left, -top );
+        }
+
+        cache->insert( key, layout );
+    }
+
+    return true;
+}
+
+static QSizeF qwtLabelSize( const QwtText &label, const QFont &font )
+{
+    QwtLabelLayout layout;
+    if ( qwtLabelLayout( label, font, layout ) )
+        return layout.size;
+
+    return label.textSize( font );
+}
+
+#if QT_VERSION >= 0x040700
+
+static bool qwtCanDrawStaticText( const QPainter *painter )
+{
+    // QStaticText is not shared between threads
+    if ( !QwtPainter::isGuiThread() )
+        return false;
+
+    // QDesktopWidget is not available without a QApplication
+    if ( qobject_cast<const QApplication *>( QCoreApplication::instance() ) == NULL )
+        return false;
+
+    /*
+        QwtPainter::drawText() adjusts fonts to the resolution
+        of printers, what is not done for static texts.
+     */
+    const QPaintDevice *device = painter->device();
+    const QWidget *desktop = QApplication::desktop();
+
+    return ( device->logicalDpiX() == desktop->logicalDpiX() )
+        && ( device->logicalDpiY() == desktop->logicalDpiY() );
+}
+
+static bool qwtDrawStaticText( QPainter *painter, const QwtText &label )
+{
+    if ( !qwtCanDrawStaticText( painter ) )
+        return false;
+
+    QwtLabelLayout layout;
+    if ( !qwtLabelLayout( label, painter->font(), layout ) )
+        return false;
+
+    const QFont font = label.usedFont( painter->font() );
+
+    if ( !layout.isPrepared )
+    {
+        layout.staticText.setText( label.text() );
+        layout.staticText.setTextFormat( Qt::PlainText );
+        layout.staticText.prepare( QTransform(), font );
+        layout.isPrepared = true;
+
+        QwtLabelLayoutCache::instance()->insert(
+            qwtLabelKey( label, painter->font() ), layout );
+    }
+
+    painter->save();
+
+    painter->setFont( font );
+
+    if ( label.testPaintAttribute( QwtText::PaintUsingTextColor ) )
+    {
+        if ( label.color().isValid() )
+            painter->setPen( label.color() );
+    }
+
+    painter->drawStaticText( layout.offset, layout.staticText );
+
+    painter->restore();
+
+    return true;
+}
+
+#endif
 
 #if QT_VERSION < 0x040601
 #define qFastSin(x) std::sin(x)
@@ -778,14 +986,19 @@ void QwtScaleDraw::drawLabel( QPainter *painter, double value ) const
 
     QPointF pos = labelPosition( value );
 
-    QSizeF labelSize = lbl.textSize( painter->font() );
+    QSizeF labelSize = qwtLabelSize( lbl, painter->font() );
 
     const QTransform transform = labelTransformation( pos, labelSize );
 
     painter->save();
     painter->setWorldTransform( transform, true );
 
-    lbl.draw ( painter, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
+#if QT_VERSION >= 0x040700
+    if ( !qwtDrawStaticText( painter, lbl ) )
+#endif
+    {
+        lbl.draw ( painter, QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
+    }
 
     painter->restore();
 }
@@ -809,7 +1022,7 @@ QRect QwtScaleDraw::boundingLabelRect( const QFont &font, double value ) const
         return QRect();
 
     const QPointF pos = labelPosition( value );
-    QSizeF labelSize = lbl.textSize( font );
+    QSizeF labelSize = qwtLabelSize( lbl, font );
 
     const QTransform transform = labelTransformation( pos, labelSize );
     return transform.mapRect( QRect( QPoint( 0, 0 ), labelSize.toSize() ) );
@@ -903,7 +1116,7 @@ QRectF QwtScaleDraw::labelRect( const QFont &font, double value ) const
 
     const QPointF pos = labelPosition( value );
 
-    const QSizeF labelSize = lbl.textSize( font );
+    const QSizeF labelSize = qwtLabelSize( lbl, font );
     const QTransform transform = labelTransformation( pos, labelSize );
 
     QRectF br = transform.mapRect( QRectF( QPointF( 0, 0 ), labelSize ) );
@@ -13,6 +13,10 @@
 #include <qrect.h>
 #include <qdebug.h>
 
+#ifndef QT_NO_RTTI
+#include <typeinfo>
+#endif
+
 /*!
   \brief Constructor
 
@@ -25,7 +29,9 @@ QwtScaleMap::QwtScaleMap():
     d_p2( 1.0 ),
     d_cnv( 1.0 ),
     d_ts1( 0.0 ),
-    d_transform( NULL )
+    d_transform( NULL ),
+    d_transformType( LinearTransform ),
+    d_exponent( 1.0 )
 {
 }
 
@@ -37,7 +43,9 @@ QwtScaleMap::QwtScaleMap( const QwtScaleMap& other ):
     d_p2( other.d_p2 ),
     d_cnv( other.d_cnv ),
     d_ts1( other.d_ts1 ),
-    d_transform( NULL )
+    d_transform( NULL ),
+    d_transformType( other.d_transformType ),
+    d_exponent( other.d_exponent )
 {
     if ( other.d_transform )
         d_transform = other.d_transform->copy();
@@ -67,6 +75,9 @@ QwtScaleMap &QwtScaleMap::operator=( const QwtScaleMap & other )
     if ( other.d_transform )
         d_transform = other.d_transform->copy();
 
+    d_transformType = other.d_transformType;
+    d_exponent = other.d_exponent;
+
     return *this;
 }
 
@@ -81,9 +92,87 @@ void QwtScaleMap::setTransformation( QwtTransform *transform )
         d_transform = transform;
     }
 
+    updateTransformType();
     setScaleInterval( d_s1, d_s2 );
 }
 
+void QwtScaleMap::updateTransformType()
+{
+    d_transformType = CustomTransform;
+    d_exponent = 1.0;
+
+#ifndef QT_NO_RTTI
+    /*
+        Derived classes might have overloaded the transformation,
+        so we need the exact type. Without RTTI all transformations
+        are evaluated by the virtual methods of QwtTransform.
+     */
+
+    if ( d_transform == NULL
+        || typeid( *d_transform ) == typeid( QwtNullTransform ) )
+    {
+        d_transformType = LinearTransform;
+    }
+    else if ( typeid( *d_transform ) == typeid( QwtLogTransform ) )
+    {
+        d_transformType = LogTransform;
+    }
+    else if ( typeid( *d_transform ) == typeid( QwtPowerTransform ) )
+    {
+        d_transformType = PowerTransform;
+        d_exponent = static_cast< const QwtPowerTransform * >(
+            d_transform )->exponent();
+    }
+#else
+    if ( d_transform == NULL )
+        d_transformType = LinearTransform;
+#endif
+}
+
+/*!
+  Transform an array of values from scale to paint device coordinates
+
+  The transformation is selected once for all values,
+  what is faster than calling transform() for each value.
+
+  \param values Values relative to the coordinates of the scale
+  \param result Array for the transformed values, might be
+                the same as values
+  \param count Number of values
+
+  \sa transform( double )
+*/
+void QwtScaleMap::transform( const double *values,
+    double *result, int count ) const
+{
+    const double p1 = d_p1;
+    const double ts1 = d_ts1;
+    const double cnv = d_cnv;
+
+    switch ( d_transformType )
+    {
+        case LinearTransform:
+        {
+            for ( int i = 0; i < count; i++ )
+                result[i] = p1 + ( values[i] - ts1 ) * cnv;
+
+            break;
+        }
+        case LogTransform:
+        {
+            for ( int i = 0; i < count; i++ )
+                result[i] = p1 + ( std::log( values[i] ) - ts1 ) * cnv;
+
+            break;
+        }
+        default:
+        {
+            for ( int i = 0; i < count; i++ )
+                result[i] = p1 + ( transformed( values[i] ) - ts1 ) * cnv;
+        }
+    }
+}
+
 //! Get the transformation
 const QwtTransform *QwtScaleMap::transformation() const
 {
@@ -131,8 +220,8 @@ void QwtScaleMap::updateFactor()
 
     if ( d_transform )
     {
-        d_ts1 = d_transform->transform( d_ts1 );
-        ts2 = d_transform->transform( ts2 );
+        d_ts1 = transformed( d_ts1 );
+        ts2 = transformed( ts2 );
     }
 
     d_cnv = 1.0;
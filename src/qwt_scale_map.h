@@ -13,6 +13,8 @@
 #include "qwt_global.h"
 #include "qwt_transform.h"
 
+#include <cmath>
+
 class QPointF;
 class QRectF;
 
@@ -42,6 +44,8 @@ public:
     double transform( double s ) const;
     double invTransform( double p ) const;
 
+    void transform( const double *values, double *result, int count ) const;
+
     double p1() const;
     double p2() const;
 
@@ -66,7 +70,23 @@ public:
     bool isInverting() const;
 
 private:
+    /*
+        The built-in transformations are evaluated inline
+        to avoid the virtual calls for each value
+     */
+    enum TransformType
+    {
+        LinearTransform,
+        LogTransform,
+        PowerTransform,
+        CustomTransform
+    };
+
     void updateFactor();
+    void updateTransformType();
+
+    double transformed( double s ) const;
+    double invTransformed( double s ) const;
 
     double d_s1, d_s2;     // scale interval boundaries
     double d_p1, d_p2;     // paint device interval boundaries
@@ -75,6 +95,9 @@ private:
     double d_ts1;
 
     QwtTransform *d_transform;
+
+    TransformType d_transformType;
+    double d_exponent;  // QwtPowerTransform::exponent()
 };
 
 /*!
@@ -136,10 +159,7 @@ inline double QwtScaleMap::sDist() const
 */
 inline double QwtScaleMap::transform( double s ) const
 {
-    if ( d_transform )
-        s = d_transform->transform( s );
-
-    return d_p1 + ( s - d_ts1 ) * d_cnv;
+    return d_p1 + ( transformed( s ) - d_ts1 ) * d_cnv;
 }
 
 /*!
@@ -153,11 +173,55 @@ inline double QwtScaleMap::transform( double s ) const
 */
 inline double QwtScaleMap::invTransform( double p ) const
 {
-    double s = d_ts1 + ( p - d_p1 ) / d_cnv;
-    if ( d_transform )
-        s = d_transform->invTransform( s );
+    return invTransformed( d_ts1 + ( p - d_p1 ) / d_cnv );
+}
 
-    return s;
+//! The same as QwtTransform::transform() of the transformation
+inline double QwtScaleMap::transformed( double s ) const
+{
+    switch ( d_transformType )
+    {
+        case LinearTransform:
+            return s;
+
+        case LogTransform:
+            return std::log( s );
+
+        case PowerTransform:
+        {
+            if ( s < 0.0 )
+                return -std::pow( -s, 1.0 / d_exponent );
+            else
+                return std::pow( s, 1.0 / d_exponent );
+        }
+
+        default:
+            return d_transform->transform( s );
+    }
+}
+
+//! The same as QwtTransform::invTransform() of the transformation
+inline double QwtScaleMap::invTransformed( double s ) const
+{
+    switch ( d_transformType )
+    {
+        case LinearTransform:
+            return s;
+
+        case LogTransform:
+            return std::exp( s );
+
+        case PowerTransform:
+        {
+            if ( s < 0.0 )
+                return -std::pow( -s, d_exponent );
+            else
+                return std::pow( s, d_exponent );
+        }
+
+        default:
+            return d_transform->invTransform( s );
+    }
 }
 
 //! \return True, when ( p1() < p2() ) != ( s1() < s2() )
@@ -0,0 +1,503 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_spatial_index.h"
+#include "qwt_series_data.h"
+#include "qwt_scale_map.h"
+#include "qwt_math.h"
+
+#include <qrect.h>
+
+#include <algorithm>
+#include <limits>
+
+// average number of points in a cell
+static const int qwtPointsPerCell = 4;
+static const int qwtMaxCells = 1 << 22;
+
+static inline bool qwtIsFinite( const QPointF &pos )
+{
+    return qIsFinite( pos.x() ) && qIsFinite( pos.y() );
+}
+
+static inline bool qwtIntersects( const QRectF &rect1, const QRectF &rect2 )
+{
+    // QRectF::intersects fails for rectangles without width or height
+    return ( rect1.left() <= rect2.right() ) && ( rect1.right() >= rect2.left() )
+        && ( rect1.top() <= rect2.bottom() ) && ( rect1.bottom() >= rect2.top() );
+}
+
+static inline bool qwtContains( const QRectF &rect, const QPointF &pos )
+{
+    return ( pos.x() >= rect.left() ) && ( pos.x() <= rect.right() )
+        && ( pos.y() >= rect.top() ) && ( pos.y() <= rect.bottom() );
+}
+
+static inline QRectF qwtDataRect( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QPointF &pos, double radius )
+{
+    const QPointF p1( xMap.invTransform( pos.x() - radius ),
+        yMap.invTransform( pos.y() - radius ) );
+
+    const QPointF p2( xMap.invTransform( pos.x() + radius ),
+        yMap.invTransform( pos.y() + radius ) );
+
+    return QRectF( p1, p2 ).normalized();
+}
+
+static int qwtClosestPoint( const QwtSeriesData<QPointF> *series,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QPointF &pos, double *dist )
+{
+    const size_t numSamples = series->size();
+
+    int index = -1;
+    double dmin = 1.0e10;
+
+    for ( uint i = 0; i < numSamples; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        const double cx = xMap.transform( sample.x() ) - pos.x();
+        const double cy = yMap.transform( sample.y() ) - pos.y();
+
+        const double f = qwtSqr( cx ) + qwtSqr( cy );
+        if ( f < dmin )
+        {
+            index = i;
+            dmin = f;
+        }
+    }
+
+    if ( dist )
+        *dist = std::sqrt( dmin );
+
+    return index;
+}
+
+class QwtSpatialIndex::PrivateData
+{
+public:
+    PrivateData():
+        dataSize( 0 ),
+        numColumns( 0 ),
+        numRows( 0 ),
+        sx( 0.0 ),
+        sy( 0.0 )
+    {
+    }
+
+    inline int column( double x ) const
+    {
+        const double v = ( x - boundingRect.left() ) * sx;
+        if ( !( v > 0.0 ) )
+            return 0;
+
+        if ( v >= numColumns )
+            return numColumns - 1;
+
+        return static_cast< int >( v );
+    }
+
+    inline int row( double y ) const
+    {
+        const double v = ( y - boundingRect.top() ) * sy;
+        if ( !( v > 0.0 ) )
+            return 0;
+
+        if ( v >= numRows )
+            return numRows - 1;
+
+        return static_cast< int >( v );
+    }
+
+    inline int cell( const QPointF &pos ) const
+    {
+        return row( pos.y() ) * numColumns + column( pos.x() );
+    }
+
+    template< typename Functor >
+    void forEachIndex( const QRectF &rect, Functor &functor ) const
+    {
+        if ( !qwtIntersects( rect, boundingRect ) )
+            return;
+
+        const int c1 = column( rect.left() );
+        const int c2 = column( rect.right() );
+        const int r1 = row( rect.top() );
+        const int r2 = row( rect.bottom() );
+
+        const int *start = cellStart.constData();
+        const int *idx = indexes.constData();
+
+        for ( int r = r1; r <= r2; r++ )
+        {
+            // the cells of a row are contiguous
+            const int from = start[ r * numColumns + c1 ];
+            const int to = start[ r * numColumns + c2 + 1 ];
+
+            for ( int i = from; i < to; i++ )
+                functor( idx[i] );
+        }
+    }
+
+    QRectF boundingRect;
+    size_t dataSize;
+
+    int numColumns;
+    int numRows;
+
+    // cells per unit
+    double sx;
+    double sy;
+
+    // the indexes of cell i are indexes[cellStart[i]] ... indexes[cellStart[i+1] - 1]
+    QVector<int> cellStart;
+    QVector<int> indexes;
+};
+
+namespace
+{
+    class QwtClosestPointFunctor
+    {
+    public:
+        QwtClosestPointFunctor( const QwtSeriesData<QPointF> *series,
+                const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                const QPointF &pos ):
+            index( -1 ),
+            dmin( 1.0e10 ),
+            m_series( series ),
+            m_xMap( xMap ),
+            m_yMap( yMap ),
+            m_pos( pos )
+        {
+        }
+
+        inline void operator()( int i )
+        {
+            const QPointF sample = m_series->sample( i );
+
+            const double cx = m_xMap.transform( sample.x() ) - m_pos.x();
+            const double cy = m_yMap.transform( sample.y() ) - m_pos.y();
+
+            const double f = qwtSqr( cx ) + qwtSqr( cy );
+
+            // the same result as iterating over all points
+            if ( f < dmin || ( f == dmin && i < index ) )
+            {
+                index = i;
+                dmin = f;
+            }
+        }
+
+        int index;
+        double dmin;
+
+    private:
+        const QwtSeriesData<QPointF> *m_series;
+        const QwtScaleMap &m_xMap;
+        const QwtScaleMap &m_yMap;
+        const QPointF m_pos;
+    };
+
+    class QwtRectFunctor
+    {
+    public:
+        QwtRectFunctor( const QwtSeriesData<QPointF> *series,
+                const QRectF &rect ):
+            m_series( series ),
+            m_rect( rect )
+        {
+        }
+
+        inline void operator()( int i )
+        {
+            if ( qwtContains( m_rect, m_series->sample( i ) ) )
+                indexes += i;
+        }
+
+        QVector<int> indexes;
+
+    private:
+        const QwtSeriesData<QPointF> *m_series;
+        const QRectF m_rect;
+    };
+}
+
+//! Constructor
+QwtSpatialIndex::QwtSpatialIndex()
+{
+    d_data = new PrivateData;
+}
+
+//! Destructor
+QwtSpatialIndex::~QwtSpatialIndex()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Build the index for a series
+
+  Points with non finite coordinates are not indexed. The size
+  of the grid is adjusted to the number of points and the
+  aspect ratio of their bounding rectangle.
+
+  \param series Series of points
+  \sa clear(), dataSize()
+ */
+void QwtSpatialIndex::build( const QwtSeriesData<QPointF> *series )
+{
+    clear();
+
+    if ( series == NULL )
+        return;
+
+    const size_t numSamples = series->size();
+    if ( numSamples == 0 ||
+        numSamples > size_t( std::numeric_limits<int>::max() ) )
+    {
+        return;
+    }
+
+    d_data->dataSize = numSamples;
+
+    const int n = static_cast< int >( numSamples );
+
+    double minX = 0.0;
+    double maxX = -1.0;
+    double minY = 0.0;
+    double maxY = -1.0;
+
+    int numPoints = 0;
+
+    for ( int i = 0; i < n; i++ )
+    {
+        const QPointF sample = series->sample( i );
+        if ( !qwtIsFinite( sample ) )
+            continue;
+
+        if ( numPoints++ == 0 )
+        {
+            minX = maxX = sample.x();
+            minY = maxY = sample.y();
+        }
+        else
+        {
+            minX = qMin( minX, sample.x() );
+            maxX = qMax( maxX, sample.x() );
+            minY = qMin( minY, sample.y() );
+            maxY = qMax( maxY, sample.y() );
+        }
+    }
+
+    if ( numPoints == 0 )
+        return;
+
+    const double w = maxX - minX;
+    const double h = maxY - minY;
+
+    const int numCells = qBound( 1, numPoints / qwtPointsPerCell, qwtMaxCells );
+
+    int numColumns = 1;
+    int numRows = 1;
+
+    if ( w > 0.0 && h > 0.0 )
+    {
+        /*
+            For extreme aspect ratios w / h might overflow to infinity
+            or underflow to 0, so the number of columns is bounded
+            before it is rounded to an int.
+         */
+        double columns = std::sqrt( numCells * ( w / h ) );
+        if ( !( columns >= 1.0 ) ) // also NaN
+            columns = 1.0;
+
+        numColumns = qRound( qMin( columns, double( numCells ) ) );
+        numRows = qBound( 1, numCells / numColumns, numCells );
+    }
+    else if ( w > 0.0 )
+    {
+        numColumns = numCells;
+    }
+    else if ( h > 0.0 )
+    {
+        numRows = numCells;
+    }
+
+    d_data->boundingRect = QRectF( minX, minY, w, h );
+    d_data->numColumns = numColumns;
+    d_data->numRows = numRows;
+    d_data->sx = ( w > 0.0 ) ? numColumns / w : 0.0;
+    d_data->sy = ( h > 0.0 ) ? numRows / h : 0.0;
+
+    // counting sort of the indexes by their cells
+
+    QVector<int> cells( n );
+    int *cellValues = cells.data();
+
+    d_data->cellStart.fill( 0, numColumns * numRows + 1 );
+    int *start = d_data->cellStart.data();
+
+    for ( int i = 0; i < n; i++ )
+    {
+        const QPointF sample = series->sample( i );
+        if ( qwtIsFinite( sample ) )
+        {
+            const int cell = d_data->cell( sample );
+
+            cellValues[i] = cell;
+            start[ cell + 1 ]++;
+        }
+        else
+        {
+            cellValues[i] = -1;
+        }
+    }
+
+    for ( int i = 1; i < d_data->cellStart.size(); i++ )
+        start[i] += start[i - 1];
+
+    QVector<int> pos = d_data->cellStart;
+    int *posValues = pos.data();
+
+    d_data->indexes.resize( numPoints );
+    int *indexes = d_data->indexes.data();
+
+    for ( int i = 0; i < n; i++ )
+    {
+        if ( cellValues[i] >= 0 )
+            indexes[ posValues[ cellValues[i] ]++ ] = i;
+    }
+}
+
+//! Remove all points from the index
+void QwtSpatialIndex::clear()
+{
+    d_data->boundingRect = QRectF();
+    d_data->dataSize = 0;
+    d_data->numColumns = d_data->numRows = 0;
+    d_data->sx = d_data->sy = 0.0;
+
+    d_data->cellStart.clear();
+    d_data->indexes.clear();
+}
+
+//! \return True, when no point is indexed
+bool QwtSpatialIndex::isEmpty() const
+{
+    return d_data->indexes.isEmpty();
+}
+
+/*!
+  \return Size of the series, when the index has been built
+  \sa build()
+ */
+size_t QwtSpatialIndex::dataSize() const
+{
+    return d_data->dataSize;
+}
+
+//! \return Bounding rectangle of the indexed points
+QRectF QwtSpatialIndex::boundingRect() const
+{
+    return d_data->boundingRect;
+}
+
+/*!
+  \brief Find the closest point to a position in paint device coordinates
+
+  The neighbourhood of the position is searched with an increasing
+  radius until a point has been found inside of it. As the search
+  area is mapped to data coordinates, this works for all monotonic
+  transformations of the scale maps.
+
+  \param series Series, that has been indexed
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param pos Position in paint device coordinates
+  \param dist If dist != NULL, closestPoint() returns the distance between
+              the position and the closest point
+
+  \return Index of the closest point, or -1 if none can be found
+  \sa QwtPlotCurve::closestPoint()
+ */
+int QwtSpatialIndex::closestPoint( const QwtSeriesData<QPointF> *series,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QPointF &pos, double *dist ) const
+{
+    if ( series == NULL || isEmpty() )
+    {
+        if ( dist )
+            *dist = 1.0e5;
+
+        return -1;
+    }
+
+    const QRectF &br = d_data->boundingRect;
+
+    const QRectF paintRect = QRectF(
+        QPointF( xMap.transform( br.left() ), yMap.transform( br.top() ) ),
+        QPointF( xMap.transform( br.right() ), yMap.transform( br.bottom() ) ) ).normalized();
+
+    if ( !( qwtIsFinite( paintRect.topLeft() ) && qwtIsFinite( paintRect.bottomRight() ) ) )
+        return qwtClosestPoint( series, xMap, yMap, pos, dist );
+
+    QwtClosestPointFunctor functor( series, xMap, yMap, pos );
+
+    for ( double radius = 8.0; ; radius *= 4.0 )
+    {
+        const QRectF rect = qwtDataRect( xMap, yMap, pos, radius );
+        if ( !( qwtIsFinite( rect.topLeft() ) && qwtIsFinite( rect.bottomRight() ) ) )
+            return qwtClosestPoint( series, xMap, yMap, pos, dist );
+
+        d_data->forEachIndex( rect, functor );
+
+        // all points closer than radius are inside of the search area
+        if ( functor.index >= 0 && functor.dmin <= radius * radius )
+            break;
+
+        // all points have been checked
+        if ( pos.x() - radius <= paintRect.left()
+            && pos.x() + radius >= paintRect.right()
+            && pos.y() - radius <= paintRect.top()
+            && pos.y() + radius >= paintRect.bottom() )
+        {
+            break;
+        }
+
+        if ( radius > 1.0e10 )
+            break;
+    }
+
+    if ( dist )
+        *dist = std::sqrt( functor.dmin );
+
+    return functor.index;
+}
+
+/*!
+  \brief Find all points inside of a rectangle
+
+  \param series Series, that has been indexed
+  \param rect Rectangle in data coordinates
+  \return Sorted indexes of the points inside of rect
+ */
+QVector<int> QwtSpatialIndex::pointsInRect(
+    const QwtSeriesData<QPointF> *series, const QRectF &rect ) const
+{
+    if ( series == NULL || isEmpty() )
+        return QVector<int>();
+
+    QwtRectFunctor functor( series, rect.normalized() );
+    d_data->forEachIndex( rect.normalized(), functor );
+
+    std::sort( functor.indexes.begin(), functor.indexes.end() );
+    return functor.indexes;
+}
@@ -0,0 +1,63 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SPATIAL_INDEX_H
+#define QWT_SPATIAL_INDEX_H
+
+#include "qwt_global.h"
+#include <qvector.h>
+
+class QwtScaleMap;
+template <typename T> class QwtSeriesData;
+class QPointF;
+class QRectF;
+
+/*!
+  \brief A grid based index for the samples of a series
+
+  QwtSpatialIndex sorts the points of a QwtSeriesData<QPointF> into
+  the cells of a regular grid in data coordinates. Finding the points
+  close to a position or inside of a rectangle only needs to check
+  the samples of the cells in the neighbourhood instead of iterating
+  over all points.
+
+  The index does not track changes of the series. It has to be
+  rebuilt, whenever the samples have been modified.
+
+  \sa QwtPlotCurve::setSpatialIndexEnabled()
+ */
+class QWT_EXPORT QwtSpatialIndex
+{
+public:
+    QwtSpatialIndex();
+    ~QwtSpatialIndex();
+
+    void build( const QwtSeriesData<QPointF> * );
+    void clear();
+
+    bool isEmpty() const;
+    size_t dataSize() const;
+
+    QRectF boundingRect() const;
+
+    int closestPoint( const QwtSeriesData<QPointF> *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QPointF &pos, double *dist = NULL ) const;
+
+    QVector<int> pointsInRect(
+        const QwtSeriesData<QPointF> *, const QRectF & ) const;
+
+private:
+    Q_DISABLE_COPY(QwtSpatialIndex)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -13,13 +13,23 @@
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qimage.h>
+#include <qmutex.h>
+#include <qhash.h>
+#include <qatomic.h>
+#include <qdatastream.h>
 #include <qpainterpath.h>
 #include <qpixmap.h>
 #include <qpaintengine.h>
+#include <qthreadpool.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #ifndef QWT_NO_SVG
 #include <qsvgrenderer.h>
 #endif
 
+#include <cstring>
+
 namespace QwtTriangle
 {
     enum Type
@@ -767,6 +777,469 @@ static inline void qwtDrawHexagonSymbols( QPainter *painter,
     }
 }
 
+/*
+    The position of a symbol split into an integer position
+    and the index of the nearest sub-pixel variant
+ */
+static inline int qwtSubPixelPos( double value, int numVariants, int &variant )
+{
+    const int v = qRound( value * numVariants );
+
+    int pos = v / numVariants;
+    int remainder = v % numVariants;
+
+    if ( remainder < 0 )
+    {
+        remainder += numVariants;
+        pos--;
+    }
+
+    variant = remainder;
+    return pos;
+}
+
+static inline QSize qwtSpriteCellSize( const QRect &boundingRect, int numVariants )
+{
+    QSize size = boundingRect.size();
+
+    // the shifted variants need one more pixel
+    if ( numVariants > 1 )
+        size += QSize( 1, 1 );
+
+    return size;
+}
+
+namespace
+{
+    /*
+        An atlas for the sprites of cached symbols. Symbols with
+        the same attributes share their sprite, and all small sprites
+        are stored in one image.
+
+        Readers receive a shallow copy of the image, so that
+        inserting new sprites ( what detaches the image )
+        doesn't interfere with symbols being stamped in other threads.
+     */
+    class QwtSymbolAtlas
+    {
+    public:
+        enum
+        {
+            AtlasSize = 512,
+            MaxSpriteSize = 128
+        };
+
+        static QwtSymbolAtlas *instance()
+        {
+            static QwtSymbolAtlas atlas;
+            return &atlas;
+        }
+
+        bool find( const QByteArray &key, QImage &image, QRect &rect )
+        {
+            QMutexLocker locker( &d_mutex );
+
+            QHash<QByteArray, QRect>::const_iterator it = d_rects.constFind( key );
+            if ( it == d_rects.constEnd() )
+                return false;
+
+            image = d_image;
+            rect = it.value();
+
+            return true;
+        }
+
+        bool insert( const QByteArray &key, const QImage &sprite,
+            QImage &image, QRect &rect )
+        {
+            const int w = sprite.width();
+            const int h = sprite.height();
+
+            if ( w > MaxSpriteSize || h > MaxSpriteSize )
+                return false;
+
+            QMutexLocker locker( &d_mutex );
+
+            if ( d_x + w > AtlasSize )
+            {
+                d_x = 0;
+                d_y += d_shelfHeight;
+                d_shelfHeight = 0;
+            }
+
+            if ( d_image.isNull() || d_y + h > AtlasSize )
+            {
+                // full: start over, the old sprites are rendered again on demand
+
+                d_image = QImage( AtlasSize, AtlasSize,
+                    QImage::Format_ARGB32_Premultiplied );
+                d_image.fill( 0 );
+
+                d_rects.clear();
+                d_x = d_y = d_shelfHeight = 0;
+            }
+
+            rect.setRect( d_x, d_y, w, h );
+
+            const int bpl = d_image.bytesPerLine();
+            uchar *bits = d_image.bits() + rect.top() * bpl
+                + rect.left() * static_cast<int>( sizeof( QRgb ) );
+
+            for ( int row = 0; row < h; row++ )
+            {
+                std::memcpy( bits + row * bpl, sprite.scanLine( row ),
+                    w * sizeof( QRgb ) );
+            }
+
+            d_x += w;
+            d_shelfHeight = qMax( d_shelfHeight, h );
+
+            d_rects.insert( key, rect );
+            image = d_image;
+
+            return true;
+        }
+
+    private:
+        QwtSymbolAtlas():
+            d_x( 0 ),
+            d_y( 0 ),
+            d_shelfHeight( 0 )
+        {
+        }
+
+        QMutex d_mutex;
+        QImage d_image;
+        QHash<QByteArray, QRect> d_rects;
+
+        int d_x;
+        int d_y;
+        int d_shelfHeight;
+    };
+
+    class QwtSymbolStamp
+    {
+    public:
+        // stamping rows y1 - y2 with "source over" in premultiplied colors
+        void stamp( int y1, int y2 ) const
+        {
+            const int w = cellSize.width();
+            const int h = cellSize.height();
+
+            for ( int i = 0; i < numPoints; i++ )
+            {
+                int variantX, variantY;
+
+                const int left = qwtSubPixelPos(
+                    points[i].x(), numVariants, variantX ) + offset.x();
+                const int top = qwtSubPixelPos(
+                    points[i].y(), numVariants, variantY ) + offset.y();
+
+                const int spriteLeft = spriteRect.left() + variantX * w;
+                const int spriteTop = spriteRect.top() + variantY * h;
+
+                const int r1 = qMax( top, y1 );
+                const int r2 = qMin( top + h - 1, y2 );
+                if ( r1 > r2 )
+                    continue;
+
+                const int c1 = qMax( left, clipRect.left() );
+                const int c2 = qMin( left + w - 1, clipRect.right() );
+                if ( c1 > c2 )
+                    continue;
+
+                for ( int row = r1; row <= r2; row++ )
+                {
+                    const QRgb *src = reinterpret_cast<const QRgb *>(
+                        spriteBits + ( spriteTop + row - top ) * spriteBytesPerLine )
+                        + spriteLeft + c1 - left;
+
+                    QRgb *dst = reinterpret_cast<QRgb *>(
+                        targetBits + row * targetBytesPerLine ) + c1;
+
+                    for ( int col = c1; col <= c2; col++ )
+                    {
+                        *dst = blend( *src, *dst );
+
+                        src++;
+                        dst++;
+                    }
+                }
+            }
+        }
+
+        uchar *targetBits;
+        int targetBytesPerLine;
+        QRect clipRect;
+
+        const uchar *spriteBits;
+        int spriteBytesPerLine;
+        QRect spriteRect;
+
+        int numVariants;
+        QSize cellSize;
+
+        const QPointF *points;
+        int numPoints;
+        QPoint offset;
+
+    private:
+        static inline QRgb blend( QRgb src, QRgb dst )
+        {
+            const uint alpha = qAlpha( src );
+            if ( alpha == 255 )
+                return src;
+
+            if ( alpha == 0 )
+                return dst;
+
+            const uint ia = 255 - alpha;
+
+            uint rb = ( dst & 0x00ff00ff ) * ia;
+            rb = ( ( rb + ( ( rb >> 8 ) & 0x00ff00ff ) + 0x00800080 ) >> 8 ) & 0x00ff00ff;
+
+            uint ag = ( ( dst >> 8 ) & 0x00ff00ff ) * ia;
+            ag = ( ag + ( ( ag >> 8 ) & 0x00ff00ff ) + 0x00800080 ) & 0xff00ff00;
+
+            return src + ( rb | ag );
+        }
+    };
+
+    class QwtSymbolStampRunnable: public QRunnable
+    {
+    public:
+        QwtSymbolStampRunnable( const QwtSymbolStamp *stamp,
+                int y1, int y2, QSemaphore *done ):
+            d_stamp( stamp ),
+            d_y1( y1 ),
+            d_y2( y2 ),
+            d_done( done )
+        {
+        }
+
+        virtual void run() QWT_OVERRIDE
+        {
+            d_stamp->stamp( d_y1, d_y2 );
+            d_done->release();
+        }
+
+    private:
+        const QwtSymbolStamp *d_stamp;
+        int d_y1;
+        int d_y2;
+        QSemaphore *d_done;
+    };
+}
+
+static QAtomicInt qwtSymbolIdCounter;
+
+static bool qwtStampTarget( const QPainter *painter,
+    QImage *&image, QRect &clipRect, QPoint &offset )
+{
+    /*
+        Stamping the sprites is only possible, when the result
+        is the same as for QPainter::drawImage with simple "source over".
+     */
+
+    QPaintDevice *device = painter->device();
+    if ( device == NULL || device->devType() != QInternal::Image )
+        return false;
+
+    image = static_cast<QImage *>( device );
+
+    if ( image->format() != QImage::Format_ARGB32_Premultiplied
+        && image->format() != QImage::Format_RGB32 )
+    {
+        return false;
+    }
+
+    if ( QwtPainter::devicePixelRatio( image ) != 1.0 )
+        return false;
+
+    if ( painter->compositionMode() != QPainter::CompositionMode_SourceOver
+        || painter->opacity() != 1.0 )
+    {
+        return false;
+    }
+
+    const QTransform transform = painter->transform();
+    if ( transform.type() > QTransform::TxTranslate )
+        return false;
+
+    const int dx = qRound( transform.dx() );
+    const int dy = qRound( transform.dy() );
+
+    if ( dx != transform.dx() || dy != transform.dy() )
+        return false;
+
+    offset = QPoint( dx, dy );
+    clipRect = image->rect();
+
+    if ( painter->hasClipping() )
+    {
+        const QRegion clipRegion = painter->clipRegion().translated( offset );
+        if ( clipRegion.rectCount() != 1 )
+            return false;
+
+        clipRect &= clipRegion.boundingRect();
+    }
+
+    return true;
+}
+
+static QByteArray qwtSymbolKey( const QwtSymbol &symbol,
+    uint symbolId, QPainter::RenderHints hints )
+{
+    QByteArray key;
+
+    QDataStream stream( &key, QIODevice::WriteOnly );
+    stream << ( hints & QPainter::Antialiasing ? 1 : 0 );
+    stream << symbol.subPixelVariants();
+
+    const QPen &pen = symbol.pen();
+    const QBrush &brush = symbol.brush();
+
+    const bool isShareable = ( symbol.style() >= QwtSymbol::Ellipse )
+        && ( symbol.style() < QwtSymbol::Path )
+        && ( brush.style() == Qt::NoBrush || brush.style() == Qt::SolidPattern )
+        && ( pen.brush().style() == Qt::SolidPattern );
+
+    if ( !isShareable )
+    {
+        // only the symbol itself can use its sprite
+        stream << QString( "#" ) << symbolId;
+        return key;
+    }
+
+    stream << static_cast<int>( symbol.style() ) << symbol.size();
+
+    stream << static_cast<int>( pen.style() ) << pen.widthF()
+        << pen.color().rgba() << static_cast<int>( pen.capStyle() )
+        << static_cast<int>( pen.joinStyle() ) << pen.isCosmetic();
+
+    stream << static_cast<int>( brush.style() ) << brush.color().rgba();
+
+    stream << symbol.isPinPointEnabled() << symbol.pinPoint();
+
+    return key;
+}
+
+static void qwtStampSymbols( QPainter *painter, const QRect &clipRect,
+    const QImage &sprite, const QRect &spriteRect,
+    int numVariants, const QSize &cellSize,
+    const QPointF *points, int numPoints,
+    const QPoint &painterOffset, const QPoint &spriteOffset )
+{
+    if ( clipRect.isEmpty() || numPoints <= 0 )
+        return;
+
+    // the area of the device, that is affected by the symbols
+
+    const QPoint offset = painterOffset + spriteOffset;
+
+    int x1 = qwtFloor( points[0].x() );
+    int x2 = x1;
+    int y1 = qwtFloor( points[0].y() );
+    int y2 = y1;
+
+    for ( int i = 1; i < numPoints; i++ )
+    {
+        const int x = qwtFloor( points[i].x() );
+        const int y = qwtFloor( points[i].y() );
+
+        x1 = qMin( x1, x );
+        x2 = qMax( x2, x );
+        y1 = qMin( y1, y );
+        y2 = qMax( y2, y );
+    }
+
+    const QRect rect = clipRect & QRect( QPoint( x1, y1 ) + offset,
+        QPoint( x2, y2 ) + offset + QPoint( cellSize.width(), cellSize.height() ) );
+
+    if ( rect.isEmpty() )
+        return;
+
+    /*
+        The image of the painter must not be modified, while the painter
+        is active. So the sprites are stamped into an image of their own,
+        that is blitted with "source over" - what gives the same result.
+     */
+    QImage layer( rect.size(), QImage::Format_ARGB32_Premultiplied );
+    layer.fill( 0 );
+
+    QwtSymbolStamp stamp;
+    stamp.targetBits = layer.bits();
+    stamp.targetBytesPerLine = layer.bytesPerLine();
+    stamp.clipRect = layer.rect();
+    stamp.spriteBits = sprite.bits();
+    stamp.spriteBytesPerLine = sprite.bytesPerLine();
+    stamp.spriteRect = spriteRect;
+    stamp.numVariants = numVariants;
+    stamp.cellSize = cellSize;
+    stamp.points = points;
+    stamp.numPoints = numPoints;
+    stamp.offset = offset - rect.topLeft();
+
+    /*
+        Distributing the rows over the threads of the pool,
+        that has been installed by QwtRenderScheduler,
+        when it is worth it
+     */
+
+    QThreadPool *threadPool = QwtPainter::threadPool();
+
+    int numParts = 1;
+
+    const qint64 numPixels = qint64( numPoints )
+        * cellSize.width() * cellSize.height();
+
+    if ( threadPool && numPixels > 500000 )
+    {
+        numParts = qMin( threadPool->maxThreadCount() + 1,
+            rect.height() / qMax( cellSize.height(), 16 ) );
+
+        numParts = qMax( numParts, 1 );
+    }
+
+    const int numRows = rect.height();
+
+    /*
+        Bands are only started, when a thread of the pool is available.
+        Otherwise they are stamped in the calling thread, so that
+        nested renders from the pool can't deadlock.
+     */
+    QSemaphore done;
+    int numStarted = 0;
+
+    for ( int i = 1; i < numParts; i++ )
+    {
+        const int row1 = i * numRows / numParts;
+        const int row2 = ( i + 1 ) * numRows / numParts - 1;
+
+        if ( row1 > row2 )
+            continue;
+
+        QwtSymbolStampRunnable *runnable =
+            new QwtSymbolStampRunnable( &stamp, row1, row2, &done );
+
+        if ( threadPool->tryStart( runnable ) )
+        {
+            numStarted++;
+        }
+        else
+        {
+            delete runnable;
+            stamp.stamp( row1, row2 );
+        }
+    }
+
+    stamp.stamp( 0, numRows / numParts - 1 );
+
+    done.acquire( numStarted );
+
+    painter->drawImage( rect.topLeft() - painterOffset, layer );
+}
+
 class QwtSymbol::PrivateData
 {
 public:
@@ -779,6 +1252,8 @@ public:
         isPinPointEnabled( false )
     {
         cache.policy = QwtSymbol::AutoCache;
+        cache.subPixelVariants = 1;
+        cache.symbolId = 0;
 #ifndef QWT_NO_SVG
         svg.renderer = NULL;
 #endif
@@ -828,8 +1303,15 @@ public:
     struct PaintCache
     {
         QwtSymbol::CachePolicy policy;
+        int subPixelVariants;
         QPixmap pixmap;
 
+        // sprites, that don't fit into the atlas
+        QMutex mutex;
+        uint symbolId;
+        QByteArray spriteKey;
+        QImage sprite;
+
     } cache;
 };
 
@@ -1294,6 +1776,76 @@ bool QwtSymbol::isPinPointEnabled() const
     return d_data->isPinPointEnabled;
 }
 
+/*!
+  \brief Set the number of sub-pixel positions, that are cached
+
+  Symbols painted from a cache are aligned to integer positions.
+  When numVariants > 1, the cache contains numVariants x numVariants
+  variants of the symbol, that are shifted by fractions of a pixel.
+  At draw time the variant nearest to the exact position is chosen,
+  what avoids jittering of antialiased symbols at floating
+  point positions.
+
+  As the cache is also used, when rounding is disabled
+  ( see QwtPainter::setRoundingAlignment() ), it is possible
+  to paint unrounded symbols with the performance of a cache.
+
+  The default setting is 1, values are limited to [1, 8].
+
+  \param numVariants Number of variants in each direction
+  \sa subPixelVariants(), setCachePolicy()
+ */
+void QwtSymbol::setSubPixelVariants( int numVariants )
+{
+    numVariants = qBound( 1, numVariants, 8 );
+    if ( numVariants != d_data->cache.subPixelVariants )
+    {
+        d_data->cache.subPixelVariants = numVariants;
+        invalidateCache();
+    }
+}
+
+/*!
+  \return Number of sub-pixel positions in each direction, that are cached
+  \sa setSubPixelVariants()
+ */
+int QwtSymbol::subPixelVariants() const
+{
+    return d_data->cache.subPixelVariants;
+}
+
+/*!
+  Render the sub-pixel variants of the symbol into a cache
+
+  \param painter Painter of the cache
+  \param boundingRect Bounding rectangle of the symbol
+  \param numVariants Number of variants in each direction
+ */
+void QwtSymbol::renderSprites( QPainter *painter,
+    const QRect &boundingRect, int numVariants ) const
+{
+    const QSize cellSize = qwtSpriteCellSize( boundingRect, numVariants );
+    const QPointF pos( 0.0, 0.0 );
+
+    for ( int row = 0; row < numVariants; row++ )
+    {
+        for ( int col = 0; col < numVariants; col++ )
+        {
+            const double dx = col * cellSize.width()
+                + double( col ) / numVariants - boundingRect.left();
+            const double dy = row * cellSize.height()
+                + double( row ) / numVariants - boundingRect.top();
+
+            painter->save();
+            painter->translate( dx, dy );
+
+            renderSymbols( painter, &pos, 1 );
+
+            painter->restore();
+        }
+    }
+}
+
 /*!
   Render an array of symbols
 
@@ -1316,8 +1868,14 @@ void QwtSymbol::drawSymbols( QPainter *painter,
     // Don't use the pixmap, when the paint device
     // could generate scalable vectors
 
-    if ( QwtPainter::roundingAlignment( painter ) &&
-        !painter->transform().isScaling() )
+    const int numVariants = d_data->cache.subPixelVariants;
+
+    // without rounding we can use the sub-pixel variants
+    const bool isAligning = ( numVariants > 1 )
+        ? QwtPainter::isAligning( painter )
+        : QwtPainter::roundingAlignment( painter );
+
+    if ( isAligning && !painter->transform().isScaling() )
     {
         if ( d_data->cache.policy == QwtSymbol::Cache )
         {
@@ -1391,29 +1949,113 @@ void QwtSymbol::drawSymbols( QPainter *painter,
     if ( useCache )
     {
         const QRect br = boundingRect();
+        const QSize cellSize = qwtSpriteCellSize( br, numVariants );
+
+        QImage *target = NULL;
+        QRect clipRect;
+        QPoint offset;
+
+        if ( !br.isEmpty() && qwtStampTarget( painter, target, clipRect, offset ) )
+        {
+            // stamping the sprites instead of painting them one by one
+
+            QByteArray key;
+            {
+                QMutexLocker locker( &d_data->cache.mutex );
+
+                if ( d_data->cache.symbolId == 0 )
+                    d_data->cache.symbolId = qwtSymbolIdCounter.fetchAndAddOrdered( 1 ) + 1;
+
+                key = qwtSymbolKey( *this, d_data->cache.symbolId, painter->renderHints() );
+            }
+
+            QwtSymbolAtlas *atlas = QwtSymbolAtlas::instance();
+
+            QImage spriteImage;
+            QRect spriteRect;
+
+            if ( !atlas->find( key, spriteImage, spriteRect ) )
+            {
+                QMutexLocker locker( &d_data->cache.mutex );
+
+                if ( d_data->cache.spriteKey == key )
+                {
+                    spriteImage = d_data->cache.sprite;
+                    spriteRect = spriteImage.rect();
+                }
+                else
+                {
+                    QImage sprite( cellSize * numVariants,
+                        QImage::Format_ARGB32_Premultiplied );
+                    sprite.fill( 0 );
+
+                    QPainter p( &sprite );
+                    p.setRenderHints( painter->renderHints() );
+                    renderSprites( &p, br, numVariants );
+                    p.end();
+
+                    if ( !atlas->insert( key, sprite, spriteImage, spriteRect ) )
+                    {
+                        d_data->cache.spriteKey = key;
+                        d_data->cache.sprite = sprite;
+
+                        spriteImage = sprite;
+                        spriteRect = sprite.rect();
+                    }
+                }
+            }
+
+            qwtStampSymbols( painter, clipRect, spriteImage, spriteRect,
+                numVariants, cellSize, points, numPoints, offset, br.topLeft() );
+
+            return;
+        }
 
         if ( d_data->cache.pixmap.isNull() )
         {
-            d_data->cache.pixmap = QwtPainter::backingStore( NULL, br.size() );
+            d_data->cache.pixmap = QwtPainter::backingStore( NULL, cellSize * numVariants );
             d_data->cache.pixmap.fill( Qt::transparent );
 
             QPainter p( &d_data->cache.pixmap );
             p.setRenderHints( painter->renderHints() );
-            p.translate( -br.topLeft() );
-
-            const QPointF pos( 0.0, 0.0 );
-            renderSymbols( &p, &pos, 1 );
+            renderSprites( &p, br, numVariants );
         }
 
         const int dx = br.left();
         const int dy = br.top();
 
-        for ( int i = 0; i < numPoints; i++ )
+        if ( numVariants == 1 )
         {
-            const int left = qRound( points[i].x() ) + dx;
-            const int top = qRound( points[i].y() ) + dy;
+            for ( int i = 0; i < numPoints; i++ )
+            {
+                const int left = qRound( points[i].x() ) + dx;
+                const int top = qRound( points[i].y() ) + dy;
 
-            painter->drawPixmap( left, top, d_data->cache.pixmap );
+                painter->drawPixmap( left, top, d_data->cache.pixmap );
+            }
+        }
+        else
+        {
+            const QPixmap &pm = d_data->cache.pixmap;
+
+#if QT_VERSION >= 0x050000
+            const qreal pixelRatio = pm.devicePixelRatio();
+#else
+            const qreal pixelRatio = 1.0;
+#endif
+            const qreal w = cellSize.width() * pixelRatio;
+            const qreal h = cellSize.height() * pixelRatio;
+
+            for ( int i = 0; i < numPoints; i++ )
+            {
+                int variantX, variantY;
+
+                const int left = qwtSubPixelPos( points[i].x(), numVariants, variantX ) + dx;
+                const int top = qwtSubPixelPos( points[i].y(), numVariants, variantY ) + dy;
+
+                painter->drawPixmap( QPointF( left, top ), pm,
+                    QRectF( variantX * w, variantY * h, w, h ) );
+            }
         }
     }
     else
@@ -1776,6 +2418,12 @@ void QwtSymbol::invalidateCache()
 {
     if ( !d_data->cache.pixmap.isNull() )
         d_data->cache.pixmap = QPixmap();
+
+    QMutexLocker locker( &d_data->cache.mutex );
+
+    d_data->cache.symbolId = 0;
+    d_data->cache.spriteKey.clear();
+    d_data->cache.sprite = QImage();
 }
 
 /*!
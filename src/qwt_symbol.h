@@ -142,6 +142,13 @@ public:
 
       \sa setCachePolicy(), cachePolicy()
 
+      When painting to a QImage ( QImage::Format_ARGB32_Premultiplied
+      or QImage::Format_RGB32 ) with a cache the symbols are stamped
+      into the image - for many symbols using the threads of
+      QwtPainter::threadPool().
+      Symbols of the built-in styles with the same attributes share
+      their sprite in a common atlas.
+
       \note The policy has no effect, when the symbol is painted
             to a vector graphics format ( PDF, SVG ).
       \warning Since Qt 4.8 raster is the default backend on X11
@@ -174,6 +181,9 @@ public:
     void setCachePolicy( CachePolicy );
     CachePolicy cachePolicy() const;
 
+    void setSubPixelVariants( int numVariants );
+    int subPixelVariants() const;
+
     void setSize( const QSize & );
     void setSize( int width, int height = -1 );
     const QSize &size() const;
@@ -225,6 +235,8 @@ protected:
 private:
     Q_DISABLE_COPY(QwtSymbol)
 
+    void renderSprites( QPainter *, const QRect &, int numVariants ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
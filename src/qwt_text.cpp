@@ -18,8 +18,7 @@
 #include <qpen.h>
 #include <qbrush.h>
 #include <qpainter.h>
-#include <qapplication.h>
-#include <qdesktopwidget.h>
+#include <qreadwritelock.h>
 
 namespace
 {
@@ -45,6 +44,7 @@ namespace
             return it.value();
         }
 
+        mutable QReadWriteLock d_lock;
         EngineMap d_map;
     };
 }
@@ -76,6 +76,8 @@ QwtTextEngineDict::~QwtTextEngineDict()
 const QwtTextEngine *QwtTextEngineDict::textEngine( const QString& text,
     QwtText::TextFormat format ) const
 {
+    QReadLocker locker( &d_lock );
+
     if ( format == QwtText::AutoText )
     {
         for ( EngineMap::const_iterator it = d_map.begin();
@@ -111,6 +113,8 @@ void QwtTextEngineDict::setTextEngine( QwtText::TextFormat format,
     if ( format == QwtText::PlainText && engine == NULL )
         return;
 
+    QWriteLocker locker( &d_lock );
+
     EngineMap::const_iterator it = d_map.constFind( format );
     if ( it != d_map.constEnd() )
     {
@@ -125,6 +129,8 @@ void QwtTextEngineDict::setTextEngine( QwtText::TextFormat format,
 const QwtTextEngine *QwtTextEngineDict::textEngine(
     QwtText::TextFormat format ) const
 {
+    QReadLocker locker( &d_lock );
+
     const QwtTextEngine *e = NULL;
 
     EngineMap::const_iterator it = d_map.find( format );
@@ -162,18 +168,6 @@ public:
     const QwtTextEngine *textEngine;
 };
 
-class QwtText::LayoutCache
-{
-public:
-    void invalidate()
-    {
-        textSize = QSizeF();
-    }
-
-    QFont font;
-    QSizeF textSize;
-};
-
 /*!
    Constructor
 */
@@ -181,8 +175,6 @@ QwtText::QwtText()
 {
     d_data = new PrivateData;
     d_data->textEngine = textEngine( d_data->text, PlainText );
-
-    d_layoutCache = new LayoutCache;
 }
 
 /*!
@@ -196,8 +188,6 @@ QwtText::QwtText( const QString &text, QwtText::TextFormat textFormat )
     d_data = new PrivateData;
     d_data->text = text;
     d_data->textEngine = textEngine( text, textFormat );
-
-    d_layoutCache = new LayoutCache;
 }
 
 //! Copy constructor
@@ -205,23 +195,18 @@ QwtText::QwtText( const QwtText &other )
 {
     d_data = new PrivateData;
     *d_data = *other.d_data;
-
-    d_layoutCache = new LayoutCache;
-    *d_layoutCache = *other.d_layoutCache;
 }
 
 //! Destructor
 QwtText::~QwtText()
 {
     delete d_data;
-    delete d_layoutCache;
 }
 
 //! Assignment operator
 QwtText &QwtText::operator=( const QwtText & other )
 {
     *d_data = *other.d_data;
-    *d_layoutCache = *other.d_layoutCache;
     return *this;
 }
 
@@ -258,7 +243,6 @@ void QwtText::setText( const QString &text,
 {
     d_data->text = text;
     d_data->textEngine = textEngine( text, textFormat );
-    d_layoutCache->invalidate();
 }
 
 /*!
@@ -282,11 +266,7 @@ QString QwtText::text() const
 */
 void QwtText::setRenderFlags( int renderFlags )
 {
-    if ( renderFlags != d_data->renderFlags )
-    {
-        d_data->renderFlags = renderFlags;
-        d_layoutCache->invalidate();
-    }
+    d_data->renderFlags = renderFlags;
 }
 
 /*!
@@ -513,10 +493,7 @@ double QwtText::heightForWidth( double width ) const
 */
 double QwtText::heightForWidth( double width, const QFont &defaultFont ) const
 {
-    // We want to calculate in screen metrics. So
-    // we need a font that uses screen metrics
-
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
+    const QFont font = QwtPainter::screenFont( usedFont( defaultFont ) );
 
     double h = 0;
 
@@ -559,20 +536,11 @@ QSizeF QwtText::textSize() const
 */
 QSizeF QwtText::textSize( const QFont &defaultFont ) const
 {
-    // We want to calculate in screen metrics. So
-    // we need a font that uses screen metrics
+    const QFont font = QwtPainter::screenFont( usedFont( defaultFont ) );
 
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
-
-    if ( !d_layoutCache->textSize.isValid()
-        || d_layoutCache->font != font )
-    {
-        d_layoutCache->textSize = d_data->textEngine->textSize(
-            font, d_data->renderFlags, d_data->text );
-        d_layoutCache->font = font;
-    }
-
-    QSizeF sz = d_layoutCache->textSize;
+    // the text engines share their results in QwtTextMetricsCache
+    QSizeF sz = d_data->textEngine->textSize(
+        font, d_data->renderFlags, d_data->text );
 
     if ( d_data->layoutAttributes & MinimumLayout )
     {
@@ -634,10 +602,7 @@ void QwtText::draw( QPainter *painter, const QRectF &rect ) const
     QRectF expandedRect = rect;
     if ( d_data->layoutAttributes & MinimumLayout )
     {
-        // We want to calculate in screen metrics. So
-        // we need a font that uses screen metrics
-
-        const QFont font( painter->font(), QApplication::desktop() );
+        const QFont font = QwtPainter::screenFont( painter->font() );
 
         double left, right, top, bottom;
         d_data->textEngine->textMargins(
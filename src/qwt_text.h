@@ -205,9 +205,6 @@ public:
 private:
     class PrivateData;
     PrivateData *d_data;
-
-    class LayoutCache;
-    LayoutCache *d_layoutCache;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtText::PaintAttributes )
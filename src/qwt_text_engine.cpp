@@ -9,11 +9,10 @@
 
 #include "qwt_text_engine.h"
 #include "qwt_painter.h"
+#include "qwt_text_metrics_cache.h"
 
 #include <qpainter.h>
-#include <qpixmap.h>
 #include <qimage.h>
-#include <qmap.h>
 #include <qwidget.h>
 #include <qtextobject.h>
 #include <qtextdocument.h>
@@ -85,16 +84,17 @@ class QwtPlainTextEngine::PrivateData
 public:
     int effectiveAscent( const QFont &font ) const
     {
-        const QString fontKey = font.key();
+        QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
 
-        QMap<QString, int>::const_iterator it =
-            d_ascentCache.constFind( fontKey );
+        const QString key = QwtTextMetricsCache::key(
+            "plain-ascent", font, 0, QString() );
 
-        if ( it != d_ascentCache.constEnd() )
-            return *it;
+        QSizeF size;
+        if ( cache->find( key, size ) )
+            return qRound( size.height() );
 
         const int ascent = findAscent( font );
-        d_ascentCache.insert( fontKey, ascent );
+        cache->insert( key, QSizeF( 0.0, ascent ) );
 
         return ascent;
     }
@@ -106,23 +106,27 @@ private:
         static const QColor white( Qt::white );
 
         const QFontMetrics fm( font );
-        QPixmap pm( fm.width( dummy ), fm.height() );
-        pm.fill( white );
 
-        QPainter p( &pm );
-        p.setFont( font );
-        p.drawText( 0, 0,  pm.width(), pm.height(), 0, dummy );
-        p.end();
+        // QPixmap can't be used outside of the GUI thread
+        QImage img( fm.width( dummy ), fm.height(), QImage::Format_RGB32 );
+        img.fill( white.rgb() );
+
+        // the resolution of the image might differ from the screen
+        QFont pixelFont( font );
+        pixelFont.setPixelSize( QFontInfo( font ).pixelSize() );
 
-        const QImage img = pm.toImage();
+        QPainter p( &img );
+        p.setFont( pixelFont );
+        p.drawText( 0, 0,  img.width(), img.height(), 0, dummy );
+        p.end();
 
         int row = 0;
         for ( row = 0; row < img.height(); row++ )
         {
             const QRgb *line = reinterpret_cast<const QRgb *>(
-                img.scanLine( row ) );
+                img.constScanLine( row ) );
 
-            const int w = pm.width();
+            const int w = img.width();
             for ( int col = 0; col < w; col++ )
             {
                 if ( line[col] != white.rgb() )
@@ -132,8 +136,6 @@ private:
 
         return fm.ascent();
     }
-
-    mutable QMap<QString, int> d_ascentCache;
 };
 
 //! Constructor
@@ -171,11 +173,22 @@ QwtPlainTextEngine::~QwtPlainTextEngine()
 double QwtPlainTextEngine::heightForWidth( const QFont& font, int flags,
         const QString& text, double width ) const
 {
-    const QFontMetricsF fm( font );
-    const QRectF rect = fm.boundingRect(
-        QRectF( 0, 0, width, QWIDGETSIZE_MAX ), flags, text );
+    QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
+
+    const QString key = QwtTextMetricsCache::key(
+        "plain", font, flags, text, width );
+
+    QSizeF size;
+    if ( !cache->find( key, size ) )
+    {
+        const QFontMetricsF fm( font );
+        size = fm.boundingRect(
+            QRectF( 0, 0, width, QWIDGETSIZE_MAX ), flags, text ).size();
+
+        cache->insert( key, size );
+    }
 
-    return rect.height();
+    return size.height();
 }
 
 /*!
@@ -190,11 +203,22 @@ double QwtPlainTextEngine::heightForWidth( const QFont& font, int flags,
 QSizeF QwtPlainTextEngine::textSize( const QFont &font,
     int flags, const QString& text ) const
 {
-    const QFontMetricsF fm( font );
-    const QRectF rect = fm.boundingRect(
-        QRectF( 0, 0, QWIDGETSIZE_MAX, QWIDGETSIZE_MAX ), flags, text );
+    QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
+
+    const QString key = QwtTextMetricsCache::key(
+        "plain", font, flags, text );
+
+    QSizeF size;
+    if ( !cache->find( key, size ) )
+    {
+        const QFontMetricsF fm( font );
+        size = fm.boundingRect(
+            QRectF( 0, 0, QWIDGETSIZE_MAX, QWIDGETSIZE_MAX ), flags, text ).size();
 
-    return rect.size();
+        cache->insert( key, size );
+    }
+
+    return size;
 }
 
 /*!
@@ -261,10 +285,23 @@ QwtRichTextEngine::QwtRichTextEngine()
 double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
         const QString& text, double width ) const
 {
-    QwtRichTextDocument doc( text, flags, font );
+    QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
 
-    doc.setPageSize( QSizeF( width, QWIDGETSIZE_MAX ) );
-    return doc.documentLayout()->documentSize().height();
+    const QString key = QwtTextMetricsCache::key(
+        "rich", font, flags, text, width );
+
+    QSizeF size;
+    if ( !cache->find( key, size ) )
+    {
+        QwtRichTextDocument doc( text, flags, font );
+
+        doc.setPageSize( QSizeF( width, QWIDGETSIZE_MAX ) );
+        size = doc.documentLayout()->documentSize();
+
+        cache->insert( key, size );
+    }
+
+    return size.height();
 }
 
 /*!
@@ -280,17 +317,29 @@ double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
 QSizeF QwtRichTextEngine::textSize( const QFont &font,
     int flags, const QString& text ) const
 {
-    QwtRichTextDocument doc( text, flags, font );
+    QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
+
+    const QString key = QwtTextMetricsCache::key(
+        "rich", font, flags, text );
 
-    QTextOption option = doc.defaultTextOption();
-    if ( option.wrapMode() != QTextOption::NoWrap )
+    QSizeF size;
+    if ( !cache->find( key, size ) )
     {
-        option.setWrapMode( QTextOption::NoWrap );
-        doc.setDefaultTextOption( option );
-        doc.adjustSize();
+        QwtRichTextDocument doc( text, flags, font );
+
+        QTextOption option = doc.defaultTextOption();
+        if ( option.wrapMode() != QTextOption::NoWrap )
+        {
+            option.setWrapMode( QTextOption::NoWrap );
+            doc.setDefaultTextOption( option );
+            doc.adjustSize();
+        }
+
+        size = doc.size();
+        cache->insert( key, size );
     }
 
-    return doc.size();
+    return size;
 }
 
 /*!
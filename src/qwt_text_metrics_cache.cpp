@@ -0,0 +1,187 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_text_metrics_cache.h"
+
+#include <qfont.h>
+#include <qstring.h>
+#include <qmutex.h>
+#include <qcache.h>
+
+class QwtTextMetricsCache::PrivateData
+{
+public:
+    enum
+    {
+        DefaultMaxEntries = 5000
+    };
+
+    PrivateData():
+        cache( DefaultMaxEntries )
+    {
+    }
+
+    mutable QMutex mutex;
+
+    // QCache::object() moves an entry to the front,
+    // what makes it a LRU cache
+    mutable QCache<QString, QSizeF> cache;
+
+    mutable QwtTextMetricsCache::Statistics statistics;
+};
+
+QwtTextMetricsCache::QwtTextMetricsCache()
+{
+    d_data = new PrivateData;
+}
+
+QwtTextMetricsCache::~QwtTextMetricsCache()
+{
+    delete d_data;
+}
+
+//! \return Cache, that is shared by all text engines
+QwtTextMetricsCache *QwtTextMetricsCache::instance()
+{
+    static QwtTextMetricsCache cache;
+    return &cache;
+}
+
+/*!
+  \brief Build the key for an entry
+
+  \param engine Identifier of the text engine
+  \param font Font of the text
+  \param flags Bitwise OR of the flags used like in QPainter::drawText()
+  \param text Text to be rendered
+  \param width Width for height-for-width calculations, < 0 otherwise
+
+  \return Key identifying the metrics of a text
+ */
+QString QwtTextMetricsCache::key( const char *engine, const QFont &font,
+    int flags, const QString &text, double width )
+{
+    QString k = QLatin1String( engine );
+    k += QChar( 0 );
+    k += font.key();
+    k += QChar( 0 );
+    k += QString::number( flags );
+
+    if ( width >= 0.0 )
+    {
+        k += QChar( 0 );
+        k += QString::number( width, 'g', 12 );
+    }
+
+    k += QChar( 0 );
+    k += text;
+
+    return k;
+}
+
+/*!
+  \brief Find an entry
+
+  \param key Key of the entry
+  \param size Return value for the cached size
+
+  \return True, when an entry has been found
+  \sa key(), insert()
+ */
+bool QwtTextMetricsCache::find( const QString &key, QSizeF &size ) const
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    const QSizeF *cachedSize = d_data->cache.object( key );
+    if ( cachedSize == NULL )
+    {
+        d_data->statistics.misses++;
+        return false;
+    }
+
+    d_data->statistics.hits++;
+    size = *cachedSize;
+
+    return true;
+}
+
+/*!
+  \brief Insert an entry
+
+  When the cache is full the least recently used entries are removed.
+
+  \param key Key of the entry
+  \param size Size to be cached
+
+  \sa key(), find(), setMaxEntries()
+ */
+void QwtTextMetricsCache::insert( const QString &key, const QSizeF &size )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.insert( key, new QSizeF( size ) );
+}
+
+/*!
+  \brief Set the maximum number of entries
+
+  \param numEntries Maximum number of entries. 0 disables the cache
+  \sa maxEntries(), numEntries()
+ */
+void QwtTextMetricsCache::setMaxEntries( int numEntries )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.setMaxCost( qMax( numEntries, 0 ) );
+}
+
+/*!
+  \return Maximum number of entries
+  \sa setMaxEntries(), numEntries()
+ */
+int QwtTextMetricsCache::maxEntries() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->cache.maxCost();
+}
+
+/*!
+  \return Number of cached entries
+  \sa maxEntries()
+ */
+int QwtTextMetricsCache::numEntries() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->cache.count();
+}
+
+//! Remove all entries
+void QwtTextMetricsCache::clear()
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.clear();
+}
+
+/*!
+  \return Counters for the lookups since the last reset
+  \sa resetStatistics()
+ */
+QwtTextMetricsCache::Statistics QwtTextMetricsCache::statistics() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->statistics;
+}
+
+/*!
+  Reset the counters for the lookups
+  \sa statistics()
+ */
+void QwtTextMetricsCache::resetStatistics()
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->statistics = Statistics();
+}
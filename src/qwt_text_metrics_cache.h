@@ -0,0 +1,92 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TEXT_METRICS_CACHE_H
+#define QWT_TEXT_METRICS_CACHE_H
+
+#include "qwt_global.h"
+#include <qsize.h>
+
+class QFont;
+class QString;
+
+/*!
+  \brief A process wide cache for the metrics of texts
+
+  Calculating the size of a text is expensive, especially for rich texts,
+  where a QTextDocument has to be created and laid out. As the same
+  texts ( legend entries, titles, tick labels ) are measured over and
+  over again, the text engines store their results in a cache, that is
+  shared between all engines and all threads.
+
+  The entries are identified by the text engine, the font, the layout
+  flags, the text and an optional width for height-for-width calculations.
+  The cache is bounded by a maximum number of entries. When it is
+  full the least recently used entries are removed.
+
+  \sa QwtTextEngine, QwtText
+ */
+class QWT_EXPORT QwtTextMetricsCache
+{
+public:
+    /*!
+      \brief Counters for the lookups in the cache
+      \sa statistics(), resetStatistics()
+     */
+    class Statistics
+    {
+    public:
+        Statistics():
+            hits( 0 ),
+            misses( 0 )
+        {
+        }
+
+        //! \return Ratio of successful lookups, or 0.0 without lookups
+        double hitRate() const
+        {
+            const qint64 lookups = hits + misses;
+            return ( lookups > 0 ) ? double( hits ) / lookups : 0.0;
+        }
+
+        //! Number of successful lookups
+        qint64 hits;
+
+        //! Number of lookups without a cached entry
+        qint64 misses;
+    };
+
+    static QwtTextMetricsCache *instance();
+
+    static QString key( const char *engine, const QFont &,
+        int flags, const QString &text, double width = -1.0 );
+
+    bool find( const QString &key, QSizeF &size ) const;
+    void insert( const QString &key, const QSizeF &size );
+
+    void setMaxEntries( int );
+    int maxEntries() const;
+
+    int numEntries() const;
+    void clear();
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    QwtTextMetricsCache();
+    ~QwtTextMetricsCache();
+
+    Q_DISABLE_COPY(QwtTextMetricsCache)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -0,0 +1,318 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_text_raster_cache.h"
+#include "qwt_text.h"
+#include "qwt_painter.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qpixmap.h>
+#include <qmutex.h>
+#include <qcache.h>
+
+namespace
+{
+    class QwtTextRaster
+    {
+    public:
+        QwtText text;
+        QImage image;
+    };
+}
+
+static const QString qwtRasterKeyTag( QLatin1String( "QwtTextRasterKey" ) );
+
+static QString qwtRasterKey( const QPainter *painter,
+    const QSizeF &size, qreal pixelRatio, const QwtText &text )
+{
+    /*
+        The key includes all attributes, that are compared by
+        QwtText::operator==(), beside the text engine, that can't
+        be retrieved. So texts, that differ in any other attribute,
+        don't evict each other.
+     */
+
+    int paintAttributes = 0;
+    if ( text.testPaintAttribute( QwtText::PaintUsingTextFont ) )
+        paintAttributes |= QwtText::PaintUsingTextFont;
+    if ( text.testPaintAttribute( QwtText::PaintUsingTextColor ) )
+        paintAttributes |= QwtText::PaintUsingTextColor;
+    if ( text.testPaintAttribute( QwtText::PaintBackground ) )
+        paintAttributes |= QwtText::PaintBackground;
+
+    const QPen pen = text.borderPen();
+    const QBrush brush = text.backgroundBrush();
+
+    QString key = text.text();
+    key += QChar( 0 );
+    key += text.usedFont( painter->font() ).key();
+    key += QChar( 0 );
+    key += QString::number( text.usedColor( painter->pen().color() ).rgba(), 16 );
+    key += QLatin1Char( ':' );
+    key += QString::number( text.renderFlags() );
+    key += QLatin1Char( ':' );
+    key += QString::number( paintAttributes );
+    key += QLatin1Char( ':' );
+    key += QString::number( text.borderRadius() );
+    key += QLatin1Char( ':' );
+    key += QString::number( static_cast<int>( pen.style() ) );
+    key += QLatin1Char( ',' );
+    key += QString::number( pen.widthF() );
+    key += QLatin1Char( ',' );
+    key += QString::number( pen.color().rgba(), 16 );
+    key += QLatin1Char( ',' );
+    key += QString::number( static_cast<int>( pen.capStyle() ) );
+    key += QLatin1Char( ',' );
+    key += QString::number( static_cast<int>( pen.joinStyle() ) );
+    key += QLatin1Char( ':' );
+    key += QString::number( static_cast<int>( brush.style() ) );
+    key += QLatin1Char( ',' );
+    key += QString::number( brush.color().rgba(), 16 );
+    if ( brush.style() == Qt::TexturePattern )
+    {
+        key += QLatin1Char( ',' );
+        key += QString::number( brush.texture().cacheKey() );
+    }
+    key += QLatin1Char( ':' );
+    key += QString::number( qRound( 64.0 * size.width() ) );
+    key += QLatin1Char( ':' );
+    key += QString::number( qRound( 64.0 * size.height() ) );
+    key += QLatin1Char( ':' );
+    key += QString::number( pixelRatio );
+    key += QLatin1Char( ':' );
+    key += QString::number( static_cast<int>( painter->renderHints() ) );
+
+    return key;
+}
+
+class QwtTextRasterCache::PrivateData
+{
+public:
+    enum
+    {
+        DefaultMaxSize = 16 * 1024 // kB
+    };
+
+    PrivateData():
+        rasters( DefaultMaxSize )
+    {
+    }
+
+    mutable QMutex mutex;
+    QCache<QString, QwtTextRaster> rasters;
+};
+
+QwtTextRasterCache::QwtTextRasterCache()
+{
+    d_data = new PrivateData;
+}
+
+QwtTextRasterCache::~QwtTextRasterCache()
+{
+    delete d_data;
+}
+
+//! \return Cache, that is shared by all items
+QwtTextRasterCache *QwtTextRasterCache::instance()
+{
+    static QwtTextRasterCache cache;
+    return &cache;
+}
+
+/*!
+  \brief Check if texts can be drawn from the cache
+
+  Rasterized texts are used for paint devices, where coordinates are
+  rounded to integers and which are not recording the paint operations.
+  The painter transformation must be a translation.
+
+  \param painter Painter
+  \return True, when cached texts can be used for the painter
+ */
+bool QwtTextRasterCache::isCacheable( const QPainter *painter )
+{
+    if ( !QwtPainter::roundingAlignment( painter ) )
+        return false;
+
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Picture:
+        case QPaintEngine::User: // usually QwtGraphic
+        {
+            // don't use a cache for record/replay devices
+            return false;
+        }
+        default:;
+    }
+
+    return painter->combinedTransform().type() <= QTransform::TxTranslate;
+}
+
+/*!
+  \brief Draw a text into a rectangle
+
+  When the painter is cacheable the text is drawn from an image,
+  that is rasterized when not being found in the cache. Otherwise
+  the text is drawn using QwtText::draw().
+
+  Images, that are too large for the cache, are stored in localImage,
+  when being passed. This way items with large texts - f.e. a
+  watermark - don't need to rasterize them for each paint event.
+
+  \param painter Painter
+  \param rect Rectangle
+  \param text Text
+  \param localImage Image owned by the caller, that is used for texts,
+                    that can't be stored in the cache. Might be NULL.
+
+  \sa isCacheable(), QwtText::draw()
+ */
+void QwtTextRasterCache::draw( QPainter *painter,
+    const QRectF &rect, const QwtText &text, QImage *localImage )
+{
+    if ( rect.isEmpty() || !isCacheable( painter )
+        || text.testLayoutAttribute( QwtText::MinimumLayout ) )
+    {
+        // MinimumLayout draws beyond the rectangle
+        text.draw( painter, rect );
+        return;
+    }
+
+    // extra pixels for the border and the overhang of glyphs
+
+    int margin = 1;
+    if ( text.testPaintAttribute( QwtText::PaintBackground )
+        && text.borderPen().style() != Qt::NoPen )
+    {
+        margin += qMax( qwtCeil( text.borderPen().widthF() ), 1 );
+    }
+
+#if QT_VERSION >= 0x050000
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+#else
+    const qreal pixelRatio = 1.0;
+#endif
+
+    const QString key = qwtRasterKey( painter, rect.size(), pixelRatio, text );
+
+    QImage image;
+
+    {
+        QMutexLocker locker( &d_data->mutex );
+
+        const QwtTextRaster *raster = d_data->rasters.object( key );
+        if ( raster && raster->text == text )
+            image = raster->image;
+    }
+
+    if ( image.isNull() && localImage
+        && localImage->text( qwtRasterKeyTag ) == key )
+    {
+        image = *localImage;
+    }
+
+    if ( image.isNull() )
+    {
+        const QSize size( qwtCeil( rect.width() ) + 2 * margin,
+            qwtCeil( rect.height() ) + 2 * margin );
+
+        image = QImage( size * pixelRatio, QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+        image.setDevicePixelRatio( pixelRatio );
+#endif
+        image.fill( Qt::transparent );
+
+        QPainter imagePainter( &image );
+        imagePainter.setRenderHints( painter->renderHints() );
+        imagePainter.setFont( painter->font() );
+        imagePainter.setPen( painter->pen() );
+
+        text.draw( &imagePainter,
+            QRectF( QPointF( margin, margin ), rect.size() ) );
+
+        imagePainter.end();
+
+        QwtTextRaster *raster = new QwtTextRaster;
+        raster->text = text;
+        raster->image = image;
+
+        const int cost = qMax( image.bytesPerLine() * image.height() / 1024, 1 );
+
+        bool isCached = false;
+        {
+            QMutexLocker locker( &d_data->mutex );
+
+            // QCache deletes objects exceeding maxCost() immediately
+            if ( cost <= d_data->rasters.maxCost() )
+            {
+                d_data->rasters.insert( key, raster, cost );
+                isCached = true;
+            }
+        }
+
+        if ( isCached )
+        {
+            if ( localImage )
+                *localImage = QImage();
+        }
+        else
+        {
+            delete raster;
+
+            if ( localImage )
+            {
+                image.setText( qwtRasterKeyTag, key );
+                *localImage = image;
+            }
+        }
+    }
+
+    // blit the image to a pixel aligned position
+
+    const QTransform transform = painter->combinedTransform();
+    const QPointF pos = transform.map( rect.topLeft() );
+
+    const QPointF alignedPos(
+        rect.left() + qRound( pos.x() ) - pos.x() - margin,
+        rect.top() + qRound( pos.y() ) - pos.y() - margin );
+
+    painter->drawImage( alignedPos, image );
+}
+
+/*!
+  \brief Set the maximum size for the images in the cache
+
+  \param kiloBytes Size in kilo bytes. 0 disables the cache
+  \sa maxSize()
+ */
+void QwtTextRasterCache::setMaxSize( int kiloBytes )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->rasters.setMaxCost( qMax( kiloBytes, 0 ) );
+}
+
+/*!
+  \return Maximum size for the images in kilo bytes
+  \sa setMaxSize()
+ */
+int QwtTextRasterCache::maxSize() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->rasters.maxCost();
+}
+
+//! Remove all images
+void QwtTextRasterCache::clear()
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->rasters.clear();
+}
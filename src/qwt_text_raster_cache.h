@@ -0,0 +1,66 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TEXT_RASTER_CACHE_H
+#define QWT_TEXT_RASTER_CACHE_H
+
+#include "qwt_global.h"
+
+class QwtText;
+class QPainter;
+class QRectF;
+class QImage;
+
+/*!
+  \brief A process wide cache for rendered texts
+
+  Rendering a text with QwtText::draw() is expensive, as the text has
+  to be laid out and rasterized for each paint event. For items with
+  texts, that don't change between replots - like markers or text
+  labels - QwtTextRasterCache stores the rasterized texts in images,
+  that are shared between all items and threads.
+
+  The images are created in the resolution of the device pixel ratio
+  of the paint device and are blitted to pixel aligned positions. So they
+  are only used for paint devices, where scalability doesn't matter
+  and for painter transformations without rotation or scaling. In all
+  other situations the text is drawn like with QwtText::draw().
+
+  The cache is bounded by the memory of the images. When it is
+  full the least recently used images are removed. Images, that are
+  larger than the cache, can be kept by the item in a local image.
+
+  \sa QwtPlotMarker, QwtPlotTextLabel
+ */
+class QWT_EXPORT QwtTextRasterCache
+{
+public:
+    static QwtTextRasterCache *instance();
+
+    static bool isCacheable( const QPainter * );
+
+    void draw( QPainter *, const QRectF &,
+        const QwtText &, QImage *localImage = NULL );
+
+    void setMaxSize( int kiloBytes );
+    int maxSize() const;
+
+    void clear();
+
+private:
+    QwtTextRasterCache();
+    ~QwtTextRasterCache();
+
+    Q_DISABLE_COPY(QwtTextRasterCache)
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -129,6 +129,12 @@ QwtPowerTransform::~QwtPowerTransform()
 {
 }
 
+//! \return Exponent
+double QwtPowerTransform::exponent() const
+{
+    return d_exponent;
+}
+
 /*!
   \param value Value to be transformed
   \return Exponentiation preserving the sign
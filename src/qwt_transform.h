@@ -128,6 +128,8 @@ public:
     explicit QwtPowerTransform( double exponent );
     virtual ~QwtPowerTransform();
 
+    double exponent() const;
+
     virtual double transform( double value ) const QWT_OVERRIDE;
     virtual double invTransform( double value ) const QWT_OVERRIDE;
 
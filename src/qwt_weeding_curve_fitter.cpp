@@ -8,37 +8,441 @@
  *****************************************************************************/
 
 #include "qwt_weeding_curve_fitter.h"
+#include "qwt_render_scheduler.h"
 #include "qwt_math.h"
 
 #include <qpainterpath.h>
 #include <qpolygon.h>
-#include <qstack.h>
 #include <qvector.h>
+#include <qatomic.h>
 
-class QwtWeedingCurveFitter::PrivateData
+// polygons below this size are not split for running in parallel
+static const int qwtMinParallelPoints = 100000;
+
+namespace
 {
-public:
-    PrivateData():
-        tolerance( 1.0 ),
-        chunkSize( 0 )
+    class QwtWeedingLine
+    {
+    public:
+        QwtWeedingLine( int i1 = 0, int i2 = 0 ):
+            from( i1 ),
+            to( i2 )
+        {
+        }
+
+        int from;
+        int to;
+    };
+
+    /*
+        Buffers, that are reused for all chunks processed
+        by the same thread
+     */
+    class QwtWeedingWorkspace
     {
+    public:
+        // Douglas Peucker
+        QVector<QwtWeedingLine> stack;
+
+        // Visvalingam Whyatt
+        QVector<int> prev;
+        QVector<int> next;
+        QVector<double> area;
+        QVector<int> heap;
+        QVector<int> heapPos;
+    };
+}
+
+template< typename T >
+static inline T *qwtBuffer( QVector<T> &buffer, int size )
+{
+    // growing only
+    if ( buffer.size() < size )
+        buffer.resize( qMax( size, 2 * buffer.size() ) );
+
+    return buffer.data();
+}
+
+/*
+    Simplify the points between from and to. Only the indexes of
+    the inner points are written to keep, so that chunks sharing their
+    end points can be processed in parallel.
+ */
+static void qwtDouglasPeucker( const QPointF *p, int from, int to,
+    double toleranceSqr, QwtWeedingWorkspace &workspace, char *keep )
+{
+    QVector<QwtWeedingLine> &stack = workspace.stack;
+
+    int top = 0;
+    qwtBuffer( stack, 64 )[top++] = QwtWeedingLine( from, to );
+
+    while ( top > 0 )
+    {
+        const QwtWeedingLine r = stack[--top];
+
+        // initialize line segment
+        const double vecX = p[r.to].x() - p[r.from].x();
+        const double vecY = p[r.to].y() - p[r.from].y();
+
+        const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
+
+        const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
+        const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
+
+        double maxDistSqr = 0.0;
+        int nVertexIndexMaxDistance = r.from + 1;
+        for ( int i = r.from + 1; i < r.to; i++ )
+        {
+            //compare to anchor
+            const double fromVecX = p[i].x() - p[r.from].x();
+            const double fromVecY = p[i].y() - p[r.from].y();
+
+            double distToSegmentSqr;
+            if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
+            {
+                distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
+            }
+            else
+            {
+                const double toVecX = p[i].x() - p[r.to].x();
+                const double toVecY = p[i].y() - p[r.to].y();
+                const double toVecLength = toVecX * toVecX + toVecY * toVecY;
+
+                const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
+                if ( s < 0.0 )
+                {
+                    distToSegmentSqr = toVecLength;
+                }
+                else
+                {
+                    distToSegmentSqr = std::fabs( toVecLength - s * s );
+                }
+            }
+
+            if ( maxDistSqr < distToSegmentSqr )
+            {
+                maxDistSqr = distToSegmentSqr;
+                nVertexIndexMaxDistance = i;
+            }
+        }
+
+        if ( maxDistSqr > toleranceSqr )
+        {
+            keep[nVertexIndexMaxDistance] = 1;
+
+            QwtWeedingLine *lines = qwtBuffer( stack, top + 2 );
+            lines[top++] = QwtWeedingLine( r.from, nVertexIndexMaxDistance );
+            lines[top++] = QwtWeedingLine( nVertexIndexMaxDistance, r.to );
+        }
     }
+}
 
-    double tolerance;
-    uint chunkSize;
-};
+static inline double qwtTriangleArea(
+    const QPointF &p1, const QPointF &p2, const QPointF &p3 )
+{
+    const double cross = ( p2.x() - p1.x() ) * ( p3.y() - p1.y() )
+        - ( p3.x() - p1.x() ) * ( p2.y() - p1.y() );
 
-class QwtWeedingCurveFitter::Line
+    return 0.5 * std::fabs( cross );
+}
+
+namespace
+{
+    // binary min heap of point indexes, ordered by their areas
+    class QwtAreaHeap
+    {
+    public:
+        QwtAreaHeap( const double *area, int *heap, int *heapPos, int size ):
+            m_area( area ),
+            m_heap( heap ),
+            m_pos( heapPos ),
+            m_size( size )
+        {
+            for ( int i = 0; i < size; i++ )
+                m_pos[ heap[i] ] = i;
+
+            for ( int i = size / 2 - 1; i >= 0; i-- )
+                siftDown( i );
+        }
+
+        inline bool isEmpty() const
+        {
+            return m_size == 0;
+        }
+
+        inline int top() const
+        {
+            return m_heap[0];
+        }
+
+        inline void pop()
+        {
+            if ( --m_size > 0 )
+            {
+                move( m_heap[m_size], 0 );
+                siftDown( 0 );
+            }
+        }
+
+        inline void update( int index )
+        {
+            const int pos = m_pos[index];
+
+            siftUp( pos );
+            siftDown( m_pos[index] );
+        }
+
+    private:
+        inline void move( int index, int pos )
+        {
+            m_heap[pos] = index;
+            m_pos[index] = pos;
+        }
+
+        inline bool less( int i1, int i2 ) const
+        {
+            const double a1 = m_area[ m_heap[i1] ];
+            const double a2 = m_area[ m_heap[i2] ];
+
+            // removing the points in order of their indexes, when equal
+            return ( a1 < a2 ) || ( a1 == a2 && m_heap[i1] < m_heap[i2] );
+        }
+
+        void siftUp( int pos )
+        {
+            while ( pos > 0 )
+            {
+                const int parent = ( pos - 1 ) / 2;
+                if ( !less( pos, parent ) )
+                    break;
+
+                swap( pos, parent );
+                pos = parent;
+            }
+        }
+
+        void siftDown( int pos )
+        {
+            while ( true )
+            {
+                const int left = 2 * pos + 1;
+                if ( left >= m_size )
+                    break;
+
+                int child = left;
+                if ( left + 1 < m_size && less( left + 1, left ) )
+                    child = left + 1;
+
+                if ( !less( child, pos ) )
+                    break;
+
+                swap( pos, child );
+                pos = child;
+            }
+        }
+
+        inline void swap( int pos1, int pos2 )
+        {
+            const int index1 = m_heap[pos1];
+            const int index2 = m_heap[pos2];
+
+            move( index1, pos2 );
+            move( index2, pos1 );
+        }
+
+        const double *m_area;
+        int *m_heap;
+        int *m_pos;
+        int m_size;
+    };
+}
+
+/*
+    Simplify the points between from and to. Like in qwtDouglasPeucker()
+    only the inner points are written to keep.
+ */
+static void qwtVisvalingamWhyatt( const QPointF *p, int from, int to,
+    double minArea, QwtWeedingWorkspace &workspace, char *keep )
+{
+    const int numPoints = to - from + 1;
+    if ( numPoints < 3 )
+        return;
+
+    p += from;
+    keep += from;
+
+    int *prev = qwtBuffer( workspace.prev, numPoints );
+    int *next = qwtBuffer( workspace.next, numPoints );
+    double *area = qwtBuffer( workspace.area, numPoints );
+    int *heap = qwtBuffer( workspace.heap, numPoints - 2 );
+    int *heapPos = qwtBuffer( workspace.heapPos, numPoints );
+
+    for ( int i = 1; i < numPoints - 1; i++ )
+    {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+        area[i] = qwtTriangleArea( p[i - 1], p[i], p[i + 1] );
+        heap[i - 1] = i;
+
+        keep[i] = 1;
+    }
+
+    prev[0] = -1;
+    next[0] = 1;
+    prev[numPoints - 1] = numPoints - 2;
+    next[numPoints - 1] = -1;
+
+    QwtAreaHeap areaHeap( area, heap, heapPos, numPoints - 2 );
+
+    while ( !areaHeap.isEmpty() )
+    {
+        const int i = areaHeap.top();
+
+        const double removedArea = area[i];
+        if ( removedArea >= minArea )
+            break;
+
+        areaHeap.pop();
+        keep[i] = 0;
+
+        const int i1 = prev[i];
+        const int i2 = next[i];
+
+        next[i1] = i2;
+        prev[i2] = i1;
+
+        /*
+            The effective area of a neighbour is not smaller
+            than the area of the point, that has been removed before
+         */
+        if ( i1 > 0 )
+        {
+            area[i1] = qwtMaxF( removedArea,
+                qwtTriangleArea( p[prev[i1]], p[i1], p[i2] ) );
+            areaHeap.update( i1 );
+        }
+
+        if ( i2 < numPoints - 1 )
+        {
+            area[i2] = qwtMaxF( removedArea,
+                qwtTriangleArea( p[i1], p[i2], p[next[i2]] ) );
+            areaHeap.update( i2 );
+        }
+    }
+}
+
+static inline void qwtWeed( QwtWeedingCurveFitter::Algorithm algorithm,
+    double tolerance, const QPointF *p, int from, int to,
+    QwtWeedingWorkspace &workspace, char *keep )
+{
+    if ( algorithm == QwtWeedingCurveFitter::VisvalingamWhyatt )
+    {
+        qwtVisvalingamWhyatt( p, from, to,
+            tolerance * tolerance, workspace, keep );
+    }
+    else
+    {
+        qwtDouglasPeucker( p, from, to,
+            tolerance * tolerance, workspace, keep );
+    }
+}
+
+static QPolygonF qwtStripped( const QPolygonF &points, const QVector<char> &keep )
+{
+    const int numPoints = points.size();
+
+    const QPointF *p = points.constData();
+    const char *k = keep.constData();
+
+    int numStripped = 0;
+    for ( int i = 0; i < numPoints; i++ )
+        numStripped += k[i];
+
+    QPolygonF stripped( numStripped );
+    QPointF *s = stripped.data();
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        if ( k[i] )
+            *s++ = p[i];
+    }
+
+    return stripped;
+}
+
+namespace
+{
+    class QwtWeedingTask: public QwtRenderScheduler::Task
+    {
+    public:
+        QwtWeedingTask( QwtWeedingCurveFitter::Algorithm algorithm,
+                double tolerance, const QPointF *points, int numPoints,
+                int chunkSize, char *keep ):
+            m_algorithm( algorithm ),
+            m_tolerance( tolerance ),
+            m_points( points ),
+            m_numPoints( numPoints ),
+            m_step( chunkSize - 1 ),
+            m_keep( keep ),
+            m_nextChunk( 0 )
+        {
+            m_numChunks = ( numPoints - 2 ) / m_step + 1;
+        }
+
+        inline int numChunks() const
+        {
+            return m_numChunks;
+        }
+
+        virtual void renderPart( int, int ) QWT_OVERRIDE
+        {
+            QwtWeedingWorkspace workspace;
+
+            while ( true )
+            {
+                const int chunk = m_nextChunk.fetchAndAddOrdered( 1 );
+                if ( chunk >= m_numChunks )
+                    break;
+
+                // the end point of a chunk is the start point of the next one
+                const int from = chunk * m_step;
+                const int to = qMin( from + m_step, m_numPoints - 1 );
+
+                qwtWeed( m_algorithm, m_tolerance,
+                    m_points, from, to, workspace, m_keep );
+            }
+        }
+
+    private:
+        const QwtWeedingCurveFitter::Algorithm m_algorithm;
+        const double m_tolerance;
+
+        const QPointF *m_points;
+        const int m_numPoints;
+        const int m_step;
+
+        char *m_keep;
+
+        int m_numChunks;
+        QAtomicInt m_nextChunk;
+    };
+}
+
+class QwtWeedingCurveFitter::PrivateData
 {
 public:
-    Line( int i1 = 0, int i2 = 0 ):
-        from( i1 ),
-        to( i2 )
+    PrivateData():
+        algorithm( QwtWeedingCurveFitter::DouglasPeucker ),
+        tolerance( 1.0 ),
+        chunkSize( 0 ),
+        threadCount( 1 )
     {
     }
 
-    int from;
-    int to;
+    QwtWeedingCurveFitter::Algorithm algorithm;
+    double tolerance;
+    uint chunkSize;
+    uint threadCount;
 };
 
 /*!
@@ -60,6 +464,26 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
     delete d_data;
 }
 
+/*!
+  Set the algorithm for simplifying the curve
+
+  \param algorithm Algorithm
+  \sa algorithm()
+*/
+void QwtWeedingCurveFitter::setAlgorithm( Algorithm algorithm )
+{
+    d_data->algorithm = algorithm;
+}
+
+/*!
+  \return Algorithm for simplifying the curve
+  \sa setAlgorithm()
+*/
+QwtWeedingCurveFitter::Algorithm QwtWeedingCurveFitter::algorithm() const
+{
+    return d_data->algorithm;
+}
+
 /*!
  Assign the tolerance
 
@@ -69,6 +493,10 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
  Increasing the tolerance will reduce the number of the
  resulting points.
 
+ For VisvalingamWhyatt the square of the tolerance is
+ the minimum for the area of the triangle of a point
+ and its neighbours.
+
  \param tolerance Tolerance
 
  \sa tolerance()
@@ -93,6 +521,8 @@ double QwtWeedingCurveFitter::tolerance() const
  The runtime of the Douglas Peucker algorithm increases non linear
  with the number of points. For a chunk size > 0 the polygon
  is split into pieces passed to the algorithm one by one.
+ The last point of a chunk is the first point of the following
+ chunk, so that the resulting curve has no gaps.
 
  \param numPoints Maximum for the number of points passed to the algorithm
 
@@ -116,6 +546,35 @@ uint QwtWeedingCurveFitter::chunkSize() const
     return d_data->chunkSize;
 }
 
+/*!
+  \brief Set the number of threads for processing the chunks
+
+  When numThreads != 1 the chunks are processed in parallel threads
+  of QwtRenderScheduler. Huge polygons are also split into chunks,
+  when no chunk size has been set.
+
+  The default setting is 1, processing all chunks in the calling thread.
+
+  \param numThreads Number of threads to be used for processing the chunks.
+                    If numThreads is set to 0, the system specific
+                    ideal thread count is used.
+
+  \sa threadCount(), setChunkSize()
+*/
+void QwtWeedingCurveFitter::setThreadCount( uint numThreads )
+{
+    d_data->threadCount = numThreads;
+}
+
+/*!
+  \return Number of threads to be used for processing the chunks
+  \sa setThreadCount()
+*/
+uint QwtWeedingCurveFitter::threadCount() const
+{
+    return d_data->threadCount;
+}
+
 /*!
   \param points Series of data points
   \return Curve points
@@ -126,21 +585,43 @@ QPolygonF QwtWeedingCurveFitter::fitCurve( const QPolygonF &points ) const
     if ( points.isEmpty() )
         return points;
 
-    QPolygonF fittedPoints;
-    if ( d_data->chunkSize == 0 )
+    const int numPoints = points.size();
+
+    uint numThreads = 1;
+    if ( d_data->threadCount != 1 )
     {
-        fittedPoints = simplify( points );
+        numThreads = QwtRenderScheduler::instance()->threadCount(
+            d_data->threadCount );
     }
-    else
+
+    int chunkSize = static_cast< int >( d_data->chunkSize );
+    if ( chunkSize == 0 && numThreads > 1 && numPoints >= qwtMinParallelPoints )
     {
-        for ( int i = 0; i < points.size(); i += d_data->chunkSize )
-        {
-            const QPolygonF p = points.mid( i, d_data->chunkSize );
-            fittedPoints += simplify( p );
-        }
+        // some chunks more than threads for balancing the load
+        chunkSize = numPoints / ( 4 * numThreads ) + 2;
     }
 
-    return fittedPoints;
+    if ( chunkSize == 0 || numPoints <= chunkSize )
+        return simplify( points );
+
+    QVector<char> keep( numPoints, 0 );
+    char *k = keep.data();
+
+    QwtWeedingTask task( d_data->algorithm, d_data->tolerance,
+        points.constData(), numPoints, chunkSize, k );
+
+    // the borders of the chunks are always part of the curve
+    for ( int i = 0; i < numPoints; i += chunkSize - 1 )
+        k[i] = 1;
+    k[numPoints - 1] = 1;
+
+    const int numParts = qMin( static_cast< int >( numThreads ), task.numChunks() );
+    if ( numParts > 1 )
+        QwtRenderScheduler::instance()->run( NULL, &task, numParts );
+    else
+        task.renderPart( 0, 1 );
+
+    return qwtStripped( points, keep );
 }
 
 /*!
@@ -157,85 +638,16 @@ QPainterPath QwtWeedingCurveFitter::fitCurvePath( const QPolygonF &points ) cons
 
 QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF &points ) const
 {
-    const double toleranceSqr = d_data->tolerance * d_data->tolerance;
-
-    QStack<Line> stack;
-    stack.reserve( 500 );
-
-    const QPointF *p = points.data();
-    const int nPoints = points.size();
-
-    QVector<bool> usePoint( nPoints, false );
-
-    stack.push( Line( 0, nPoints - 1 ) );
-
-    while ( !stack.isEmpty() )
-    {
-        const Line r = stack.pop();
-
-        // initialize line segment
-        const double vecX = p[r.to].x() - p[r.from].x();
-        const double vecY = p[r.to].y() - p[r.from].y();
-
-        const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
-
-        const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
-        const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
-
-        double maxDistSqr = 0.0;
-        int nVertexIndexMaxDistance = r.from + 1;
-        for ( int i = r.from + 1; i < r.to; i++ )
-        {
-            //compare to anchor
-            const double fromVecX = p[i].x() - p[r.from].x();
-            const double fromVecY = p[i].y() - p[r.from].y();
-
-            double distToSegmentSqr;
-            if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
-            {
-                distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
-            }
-            else
-            {
-                const double toVecX = p[i].x() - p[r.to].x();
-                const double toVecY = p[i].y() - p[r.to].y();
-                const double toVecLength = toVecX * toVecX + toVecY * toVecY;
-
-                const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
-                if ( s < 0.0 )
-                {
-                    distToSegmentSqr = toVecLength;
-                }
-                else
-                {
-                    distToSegmentSqr = std::fabs( toVecLength - s * s );
-                }
-            }
+    const int numPoints = points.size();
+    if ( numPoints <= 2 )
+        return points;
 
-            if ( maxDistSqr < distToSegmentSqr )
-            {
-                maxDistSqr = distToSegmentSqr;
-                nVertexIndexMaxDistance = i;
-            }
-        }
-        if ( maxDistSqr <= toleranceSqr )
-        {
-            usePoint[r.from] = true;
-            usePoint[r.to] = true;
-        }
-        else
-        {
-            stack.push( Line( r.from, nVertexIndexMaxDistance ) );
-            stack.push( Line( nVertexIndexMaxDistance, r.to ) );
-        }
-    }
+    QVector<char> keep( numPoints, 0 );
+    keep[0] = keep[numPoints - 1] = 1;
 
-    QPolygonF stripped;
-    for ( int i = 0; i < nPoints; i++ )
-    {
-        if ( usePoint[i] )
-            stripped += p[i];
-    }
+    QwtWeedingWorkspace workspace;
+    qwtWeed( d_data->algorithm, d_data->tolerance,
+        points.constData(), 0, numPoints - 1, workspace, keep.data() );
 
-    return stripped;
+    return qwtStripped( points, keep );
 }
@@ -24,8 +24,13 @@
   The runtime of the algorithm increases non linear ( worst case O( n*n ) )
   and might be very slow for huge polygons. To avoid performance issues
   it might be useful to split the polygon ( setChunkSize() ) and to run the algorithm
-  for these smaller parts. The disadvantage of having no interpolation
-  at the borders is for most use cases irrelevant.
+  for these smaller parts. Neighboured chunks share their border point, that
+  is always part of the smoothed curve. The chunks can be processed in
+  parallel threads ( setThreadCount() ).
+
+  As alternative the Visvalingam-Whyatt algorithm is available, that
+  removes the points with the smallest effective areas one by one.
+  Its runtime is O( n * log( n ) ).
 
   The smoothed curve consists of a subset of the points that defined the
   original curve.
@@ -38,23 +43,48 @@
 class QWT_EXPORT QwtWeedingCurveFitter: public QwtCurveFitter
 {
 public:
+    /*!
+      \brief Algorithm for simplifying the curve
+      \sa setAlgorithm()
+     */
+    enum Algorithm
+    {
+        /*!
+          Split the curve recursively at the point with the maximum
+          distance to the line between the end points, until all
+          distances are below the tolerance.
+         */
+        DouglasPeucker,
+
+        /*!
+          Remove the point with the smallest area of the triangle
+          with its neighbours, until all areas are above the square
+          of the tolerance.
+         */
+        VisvalingamWhyatt
+    };
+
     explicit QwtWeedingCurveFitter( double tolerance = 1.0 );
     virtual ~QwtWeedingCurveFitter();
 
+    void setAlgorithm( Algorithm );
+    Algorithm algorithm() const;
+
     void setTolerance( double );
     double tolerance() const;
 
     void setChunkSize( uint );
     uint chunkSize() const;
 
+    void setThreadCount( uint );
+    uint threadCount() const;
+
     virtual QPolygonF fitCurve( const QPolygonF & ) const QWT_OVERRIDE;
     virtual QPainterPath fitCurvePath( const QPolygonF & ) const QWT_OVERRIDE;
 
 private:
     virtual QPolygonF simplify( const QPolygonF & ) const;
 
-    class Line;
-
     class PrivateData;
     PrivateData *d_data;
 };
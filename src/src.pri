@@ -50,6 +50,8 @@ HEADERS += \
     qwt_system_clock.h \
     qwt_text_engine.h \
     qwt_text_label.h \
+    qwt_text_metrics_cache.h \
+    qwt_text_raster_cache.h \
     qwt_text.h \
     qwt_transform.h \
     qwt_widget_overlay.h
@@ -94,6 +96,8 @@ SOURCES += \
     qwt_system_clock.cpp \
     qwt_text_engine.cpp \
     qwt_text_label.cpp \
+    qwt_text_metrics_cache.cpp \
+    qwt_text_raster_cache.cpp \
     qwt_text.cpp \
     qwt_transform.cpp \
     qwt_widget_overlay.cpp
@@ -112,6 +116,8 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend_label.h \
         qwt_plot.h \
         qwt_plot_renderer.h \
+        qwt_plot_batch_renderer.h \
+        qwt_plot_description.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
@@ -125,6 +131,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_tradingcurve.h \
         qwt_plot_layout.h \
         qwt_plot_marker.h \
+        qwt_plot_marker_collection.h \
         qwt_plot_zoneitem.h \
         qwt_plot_textlabel.h \
         qwt_plot_rasteritem.h \
@@ -144,8 +151,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_rescaler.h \
         qwt_point_mapper.h \
         qwt_raster_data.h \
+        qwt_render_scheduler.h \
         qwt_matrix_raster_data.h \
         qwt_sampling_thread.h \
+        qwt_spatial_index.h \
         qwt_samples.h \
         qwt_series_data.h \
         qwt_series_store.h \
@@ -162,6 +171,8 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend_label.cpp \
         qwt_plot.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_batch_renderer.cpp \
+        qwt_plot_description.cpp \
         qwt_plot_xml.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
@@ -184,6 +195,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_shapeitem.cpp \
         qwt_plot_vectorfield.cpp \
         qwt_plot_marker.cpp \
+        qwt_plot_marker_collection.cpp \
         qwt_plot_textlabel.cpp \
         qwt_plot_layout.cpp \
         qwt_plot_abstract_canvas.cpp \
@@ -196,8 +208,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_rescaler.cpp \
         qwt_point_mapper.cpp \
         qwt_raster_data.cpp \
+        qwt_render_scheduler.cpp \
         qwt_matrix_raster_data.cpp \
         qwt_sampling_thread.cpp \
+        qwt_spatial_index.cpp \
         qwt_series_data.cpp \
         qwt_point_data.cpp \
         qwt_scale_widget.cpp
@@ -0,0 +1,351 @@
+#include <qwt_clipper.h>
+
+#include <qpolygon.h>
+#include <qrect.h>
+#include <qdebug.h>
+
+static int numFailures = 0;
+
+// a deterministic random generator, that is the same on all platforms
+static double randomValue()
+{
+    static quint32 seed = 4711;
+    seed = seed * 1103515245u + 12345u;
+
+    return ( ( seed >> 8 ) & 0xffffff ) / double( 0x1000000 );
+}
+
+static double randomValue( double min, double max )
+{
+    return min + randomValue() * ( max - min );
+}
+
+static void fail( const char *name, const char *prompt )
+{
+    qDebug() << name << ":" << prompt << "=> failed.";
+    numFailures++;
+}
+
+/*
+    The Sutherland-Hodgman algorithm, like it was implemented
+    by QwtClipper before clipping in a single streaming pass:
+    edge by edge, copying the polygon between two buffers
+ */
+namespace Reference
+{
+    template <class Point, typename Value>
+    class LeftEdge
+    {
+    public:
+        LeftEdge( Value x1, Value, Value, Value ): d_x1( x1 ) {}
+
+        bool isInside( const Point &p ) const { return p.x() >= d_x1; }
+
+        Point intersection( const Point &p1, const Point &p2 ) const
+        {
+            double dy = ( p1.y() - p2.y() ) / double( p1.x() - p2.x() );
+            return Point( d_x1, static_cast< Value >( p2.y() + ( d_x1 - p2.x() ) * dy ) );
+        }
+
+    private:
+        const Value d_x1;
+    };
+
+    template <class Point, typename Value>
+    class RightEdge
+    {
+    public:
+        RightEdge( Value, Value x2, Value, Value ): d_x2( x2 ) {}
+
+        bool isInside( const Point &p ) const { return p.x() <= d_x2; }
+
+        Point intersection( const Point &p1, const Point &p2 ) const
+        {
+            double dy = ( p1.y() - p2.y() ) / double( p1.x() - p2.x() );
+            return Point( d_x2, static_cast< Value >( p2.y() + ( d_x2 - p2.x() ) * dy ) );
+        }
+
+    private:
+        const Value d_x2;
+    };
+
+    template <class Point, typename Value>
+    class TopEdge
+    {
+    public:
+        TopEdge( Value, Value, Value y1, Value ): d_y1( y1 ) {}
+
+        bool isInside( const Point &p ) const { return p.y() >= d_y1; }
+
+        Point intersection( const Point &p1, const Point &p2 ) const
+        {
+            double dx = ( p1.x() - p2.x() ) / double( p1.y() - p2.y() );
+            return Point( static_cast< Value >( p2.x() + ( d_y1 - p2.y() ) * dx ), d_y1 );
+        }
+
+    private:
+        const Value d_y1;
+    };
+
+    template <class Point, typename Value>
+    class BottomEdge
+    {
+    public:
+        BottomEdge( Value, Value, Value, Value y2 ): d_y2( y2 ) {}
+
+        bool isInside( const Point &p ) const { return p.y() <= d_y2; }
+
+        Point intersection( const Point &p1, const Point &p2 ) const
+        {
+            double dx = ( p1.x() - p2.x() ) / double( p1.y() - p2.y() );
+            return Point( static_cast< Value >( p2.x() + ( d_y2 - p2.y() ) * dx ), d_y2 );
+        }
+
+    private:
+        const Value d_y2;
+    };
+
+    template <class Polygon, class Rect, class Edge>
+    static void clipEdge( const Rect &clipRect, bool closePolygon,
+        const Polygon &points, Polygon &clippedPoints )
+    {
+        clippedPoints.clear();
+
+        if ( points.size() < 2 )
+        {
+            if ( points.size() == 1 )
+                clippedPoints += points[0];
+
+            return;
+        }
+
+        const Edge edge( clipRect.x(), clipRect.x() + clipRect.width(),
+            clipRect.y(), clipRect.y() + clipRect.height() );
+
+        if ( !closePolygon )
+        {
+            if ( edge.isInside( points.first() ) )
+                clippedPoints += points.first();
+        }
+        else
+        {
+            const typename Polygon::value_type &p1 = points.first();
+            const typename Polygon::value_type &p2 = points.last();
+
+            if ( edge.isInside( p1 ) )
+            {
+                if ( !edge.isInside( p2 ) )
+                    clippedPoints += edge.intersection( p1, p2 );
+
+                clippedPoints += p1;
+            }
+            else if ( edge.isInside( p2 ) )
+            {
+                clippedPoints += edge.intersection( p1, p2 );
+            }
+        }
+
+        for ( int i = 1; i < points.size(); i++ )
+        {
+            const typename Polygon::value_type &p1 = points[i];
+            const typename Polygon::value_type &p2 = points[i - 1];
+
+            if ( edge.isInside( p1 ) )
+            {
+                if ( !edge.isInside( p2 ) )
+                    clippedPoints += edge.intersection( p1, p2 );
+
+                clippedPoints += p1;
+            }
+            else if ( edge.isInside( p2 ) )
+            {
+                clippedPoints += edge.intersection( p1, p2 );
+            }
+        }
+    }
+
+    template <class Polygon, class Rect, typename T>
+    static Polygon clippedPolygon( const Rect &clipRect,
+        const Polygon &polygon, bool closePolygon )
+    {
+        typedef typename Polygon::value_type Point;
+
+        Polygon points1 = polygon;
+        Polygon points2;
+
+        clipEdge< Polygon, Rect, LeftEdge<Point, T> >(
+            clipRect, closePolygon, points1, points2 );
+        clipEdge< Polygon, Rect, RightEdge<Point, T> >(
+            clipRect, closePolygon, points2, points1 );
+        clipEdge< Polygon, Rect, TopEdge<Point, T> >(
+            clipRect, closePolygon, points1, points2 );
+        clipEdge< Polygon, Rect, BottomEdge<Point, T> >(
+            clipRect, closePolygon, points2, points1 );
+
+        return points1;
+    }
+}
+
+/*
+    For closed polygons the streaming clipper processes the closing
+    edge last, what results in the same polygon with a rotated start point
+ */
+template <class Polygon>
+static bool isEqual( const Polygon &polygon1,
+    const Polygon &polygon2, bool closePolygon )
+{
+    if ( !closePolygon )
+        return polygon1 == polygon2;
+
+    if ( polygon1.size() != polygon2.size() )
+        return false;
+
+    const int n = polygon1.size();
+    if ( n == 0 )
+        return true;
+
+    for ( int offset = 0; offset < n; offset++ )
+    {
+        bool ok = true;
+        for ( int i = 0; ok && i < n; i++ )
+            ok = ( polygon1[i] == polygon2[ ( i + offset ) % n ] );
+
+        if ( ok )
+            return true;
+    }
+
+    return false;
+}
+
+static QPolygonF randomPolygonF( int numPoints, const QRectF &area )
+{
+    QPolygonF polygon;
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        polygon += QPointF( randomValue( area.left(), area.right() ),
+            randomValue( area.top(), area.bottom() ) );
+    }
+
+    return polygon;
+}
+
+static void testPolygonF( const char *name,
+    const QRectF &clipRect, const QPolygonF &polygon )
+{
+    for ( int closed = 0; closed <= 1; closed++ )
+    {
+        const bool closePolygon = ( closed != 0 );
+
+        const QPolygonF expected = Reference::clippedPolygon<QPolygonF, QRectF, double>(
+            clipRect, polygon, closePolygon );
+
+        const QPolygonF clipped =
+            QwtClipper::clippedPolygonF( clipRect, polygon, closePolygon );
+
+        if ( !isEqual( expected, clipped, closePolygon ) )
+            fail( name, closePolygon ? "clippedPolygonF, closed" : "clippedPolygonF" );
+
+        // clipping into a buffer, that is reused
+
+        QPolygonF buffer = randomPolygonF( 10, clipRect );
+
+        QwtClipper::clipPolygonF( clipRect,
+            polygon.constData(), polygon.size(), buffer, closePolygon );
+
+        if ( buffer != clipped )
+            fail( name, "clipPolygonF into a buffer" );
+
+        // adding the points in chunks of different sizes
+
+        QPolygonF streamed;
+        {
+            QwtClipper::PolygonClipperF clipper( clipRect, streamed, closePolygon );
+
+            int i = 0;
+            while ( i < polygon.size() )
+            {
+                const int n = qMin( 1 + ( i % 7 ), polygon.size() - i );
+                if ( n == 1 )
+                    clipper.addPoint( polygon[i] );
+                else
+                    clipper.addPoints( polygon.constData() + i, n );
+
+                i += n;
+            }
+
+            clipper.flush();
+        }
+
+        if ( streamed != clipped )
+            fail( name, "PolygonClipperF" );
+    }
+}
+
+static void testPolygon( const char *name,
+    const QRect &clipRect, const QPolygon &polygon )
+{
+    for ( int closed = 0; closed <= 1; closed++ )
+    {
+        const bool closePolygon = ( closed != 0 );
+
+        const QPolygon expected = Reference::clippedPolygon<QPolygon, QRect, int>(
+            clipRect, polygon, closePolygon );
+
+        const QPolygon clipped =
+            QwtClipper::clippedPolygon( clipRect, polygon, closePolygon );
+
+        if ( !isEqual( expected, clipped, closePolygon ) )
+            fail( name, closePolygon ? "clippedPolygon, closed" : "clippedPolygon" );
+    }
+}
+
+static void testClipper()
+{
+    const QRectF clipRect( 10.0, 20.0, 300.0, 200.0 );
+    const QRectF area = clipRect.adjusted( -100.0, -100.0, 100.0, 100.0 );
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        const int numPoints = 1 + i % 50;
+        testPolygonF( "Random", clipRect, randomPolygonF( numPoints, area ) );
+    }
+
+    testPolygonF( "Empty", clipRect, QPolygonF() );
+
+    testPolygonF( "Single point inside", clipRect,
+        QPolygonF() << QPointF( 50.0, 50.0 ) );
+
+    testPolygonF( "Single point outside", clipRect,
+        QPolygonF() << QPointF( -50.0, 50.0 ) );
+
+    testPolygonF( "Inside", clipRect,
+        randomPolygonF( 100, clipRect.adjusted( 1.0, 1.0, -1.0, -1.0 ) ) );
+
+    testPolygonF( "Outside", clipRect,
+        randomPolygonF( 100, QRectF( 400.0, 400.0, 100.0, 100.0 ) ) );
+
+    testPolygonF( "Surrounding", clipRect, QPolygonF()
+        << QPointF( 0.0, 0.0 ) << QPointF( 400.0, 0.0 )
+        << QPointF( 400.0, 300.0 ) << QPointF( 0.0, 300.0 ) );
+
+    // integer coordinates
+
+    const QRect intClipRect = clipRect.toRect();
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        const int numPoints = 1 + i % 50;
+
+        const QPolygon polygon =
+            randomPolygonF( numPoints, area ).toPolygon();
+
+        testPolygon( "Random int", intClipRect, polygon );
+    }
+}
+
+int main()
+{
+    testClipper();
+
+    return ( numFailures > 0 ) ? 1 : 0;
+}
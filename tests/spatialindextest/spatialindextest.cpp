@@ -0,0 +1,320 @@
+#include <qwt_spatial_index.h>
+#include <qwt_series_data.h>
+#include <qwt_scale_map.h>
+#include <qwt_transform.h>
+
+#include <qvector.h>
+#include <qrect.h>
+#include <qnumeric.h>
+#include <qdebug.h>
+
+#include <cmath>
+#include <limits>
+
+static int numFailures = 0;
+
+// a deterministic random generator, that is the same on all platforms
+static double randomValue()
+{
+    static quint32 seed = 12345;
+    seed = seed * 1103515245u + 12345u;
+
+    return ( ( seed >> 8 ) & 0xffffff ) / double( 0x1000000 );
+}
+
+static double randomValue( double min, double max )
+{
+    return min + randomValue() * ( max - min );
+}
+
+static void fail( const char *name, const char *prompt )
+{
+    qDebug() << name << ":" << prompt << "=> failed.";
+    numFailures++;
+}
+
+static int closestPoint( const QVector<QPointF> &points,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QPointF &pos, double *dist )
+{
+    int index = -1;
+    double dmin = 1.0e10;
+
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const double cx = xMap.transform( points[i].x() ) - pos.x();
+        const double cy = yMap.transform( points[i].y() ) - pos.y();
+
+        const double f = cx * cx + cy * cy;
+        if ( f < dmin )
+        {
+            index = i;
+            dmin = f;
+        }
+    }
+
+    *dist = std::sqrt( dmin );
+    return index;
+}
+
+static QVector<int> pointsInRect( const QVector<QPointF> &points,
+    const QRectF &rect )
+{
+    const QRectF r = rect.normalized();
+
+    QVector<int> indexes;
+
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const QPointF &p = points[i];
+
+        // points with non finite coordinates are not indexed
+        if ( !( qIsFinite( p.x() ) && qIsFinite( p.y() ) ) )
+            continue;
+
+        if ( p.x() >= r.left() && p.x() <= r.right()
+            && p.y() >= r.top() && p.y() <= r.bottom() )
+        {
+            indexes += i;
+        }
+    }
+
+    return indexes;
+}
+
+static void testIndex( const char *name, const QVector<QPointF> &points,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap )
+{
+    QwtPointSeriesData series( points );
+
+    QwtSpatialIndex index;
+    index.build( &series );
+
+    if ( index.dataSize() != size_t( points.size() ) )
+        fail( name, "dataSize" );
+
+    // the area to be tested includes some space outside of the points
+
+    double x1 = 0.0;
+    double x2 = 1.0;
+    double y1 = 0.0;
+    double y2 = 1.0;
+
+    bool isFirst = true;
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const QPointF &p = points[i];
+        if ( !( qIsFinite( p.x() ) && qIsFinite( p.y() ) ) )
+            continue;
+
+        if ( isFirst )
+        {
+            x1 = x2 = p.x();
+            y1 = y2 = p.y();
+            isFirst = false;
+        }
+        else
+        {
+            x1 = qMin( x1, p.x() );
+            x2 = qMax( x2, p.x() );
+            y1 = qMin( y1, p.y() );
+            y2 = qMax( y2, p.y() );
+        }
+    }
+
+    const double dx = qMax( 0.1 * ( x2 - x1 ), 1.0e-3 * qAbs( x1 ) );
+    const double dy = qMax( 0.1 * ( y2 - y1 ), 1.0e-3 * qAbs( y1 ) );
+
+    for ( int i = 0; i < 500; i++ )
+    {
+        const QPointF pos(
+            randomValue( xMap.p1() - 50.0, xMap.p2() + 50.0 ),
+            randomValue( yMap.p2() - 50.0, yMap.p1() + 50.0 ) );
+
+        double dist1, dist2;
+
+        const int index1 = closestPoint( points, xMap, yMap, pos, &dist1 );
+        const int index2 = index.closestPoint( &series, xMap, yMap, pos, &dist2 );
+
+        if ( index1 != index2 || dist1 != dist2 )
+        {
+            fail( name, "closestPoint" );
+            break;
+        }
+    }
+
+    for ( int i = 0; i < 500; i++ )
+    {
+        QRectF rect;
+        rect.setLeft( randomValue( x1 - dx, x2 + dx ) );
+        rect.setRight( randomValue( x1 - dx, x2 + dx ) );
+        rect.setTop( randomValue( y1 - dy, y2 + dy ) );
+        rect.setBottom( randomValue( y1 - dy, y2 + dy ) );
+
+        if ( i % 3 == 0 && !points.isEmpty() )
+        {
+            // edges through points, that have to be included
+
+            const QPointF &p1 = points[ int( randomValue() * points.size() ) ];
+            const QPointF &p2 = points[ int( randomValue() * points.size() ) ];
+
+            rect.setLeft( p1.x() );
+            rect.setTop( p1.y() );
+            rect.setRight( p2.x() );
+            rect.setBottom( p2.y() );
+        }
+
+        if ( i % 10 == 0 )
+        {
+            // rectangles without width
+            rect.setRight( rect.left() );
+        }
+
+        if ( pointsInRect( points, rect ) != index.pointsInRect( &series, rect ) )
+        {
+            fail( name, "pointsInRect" );
+            break;
+        }
+    }
+}
+
+static void testIndex( const char *name, const QVector<QPointF> &points )
+{
+    double x1 = 0.0;
+    double x2 = 0.0;
+    double y1 = 0.0;
+    double y2 = 0.0;
+
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        const QPointF &p = points[i];
+        if ( !( qIsFinite( p.x() ) && qIsFinite( p.y() ) ) )
+            continue;
+
+        x1 = qMin( x1, p.x() );
+        x2 = qMax( x2, p.x() );
+        y1 = qMin( y1, p.y() );
+        y2 = qMax( y2, p.y() );
+    }
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( x1, ( x2 > x1 ) ? x2 : x1 + 1.0 );
+    xMap.setPaintInterval( 0.0, 800.0 );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( y1, ( y2 > y1 ) ? y2 : y1 + 1.0 );
+    yMap.setPaintInterval( 600.0, 0.0 );
+
+    testIndex( name, points, xMap, yMap );
+}
+
+static void testSpatialIndex()
+{
+    QVector<QPointF> points;
+
+    // uniformly distributed
+
+    for ( int i = 0; i < 5000; i++ )
+        points += QPointF( randomValue( -100.0, 100.0 ), randomValue( 0.0, 10.0 ) );
+
+    testIndex( "Uniform", points );
+
+    // clusters with duplicates
+
+    points.clear();
+    for ( int i = 0; i < 5000; i++ )
+    {
+        const double cx = ( i % 5 ) * 20.0;
+        const double cy = ( i % 3 ) * 7.0;
+
+        const QPointF p( cx + randomValue( -0.5, 0.5 ),
+            cy + randomValue( -0.5, 0.5 ) );
+
+        points += p;
+
+        if ( i % 7 == 0 )
+            points += p;
+    }
+
+    testIndex( "Clusters", points );
+
+    // all points on a horizontal or vertical line
+
+    points.clear();
+    for ( int i = 0; i < 1000; i++ )
+        points += QPointF( randomValue( 0.0, 100.0 ), 5.0 );
+
+    testIndex( "Horizontal line", points );
+
+    points.clear();
+    for ( int i = 0; i < 1000; i++ )
+        points += QPointF( 5.0, randomValue( 0.0, 100.0 ) );
+
+    testIndex( "Vertical line", points );
+
+    // all points at the same position
+
+    points.clear();
+    for ( int i = 0; i < 100; i++ )
+        points += QPointF( 3.0, 4.0 );
+
+    testIndex( "Same position", points );
+
+    // extreme aspect ratio
+
+    points.clear();
+    for ( int i = 0; i < 1000; i++ )
+        points += QPointF( randomValue( 0.0, 1.0e12 ), randomValue( 0.0, 1.0e-12 ) );
+
+    testIndex( "Extreme aspect ratio", points );
+
+    // points with non finite coordinates, that are not indexed
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    points.clear();
+    for ( int i = 0; i < 1000; i++ )
+    {
+        if ( i % 10 == 0 )
+            points += QPointF( nan, randomValue( 0.0, 10.0 ) );
+        else if ( i % 10 == 1 )
+            points += QPointF( randomValue( 0.0, 10.0 ), inf );
+        else
+            points += QPointF( randomValue( 0.0, 10.0 ), randomValue( 0.0, 10.0 ) );
+    }
+
+    testIndex( "Non finite", points );
+
+    // logarithmic x axis
+
+    points.clear();
+    for ( int i = 0; i < 2000; i++ )
+    {
+        const double x = std::pow( 10.0, randomValue( -3.0, 3.0 ) );
+        points += QPointF( x, randomValue( 0.0, 10.0 ) );
+    }
+
+    QwtScaleMap xMap;
+    xMap.setTransformation( new QwtLogTransform() );
+    xMap.setScaleInterval( 1.0e-3, 1.0e3 );
+    xMap.setPaintInterval( 0.0, 800.0 );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( 0.0, 10.0 );
+    yMap.setPaintInterval( 600.0, 0.0 );
+
+    testIndex( "Logarithmic", points, xMap, yMap );
+
+    // empty series
+
+    points.clear();
+    testIndex( "Empty", points );
+}
+
+int main()
+{
+    testSpatialIndex();
+
+    return ( numFailures > 0 ) ? 1 : 0;
+}
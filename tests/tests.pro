@@ -13,4 +13,11 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     splinetest \
-    splineprof
+    splineprof \
+    clippertest
+
+contains(QWT_CONFIG, QwtPlot) {
+
+    SUBDIRS += \
+        spatialindextest
+}
@@ -11,6 +11,7 @@
 #include <qpainter.h>
 #include "qwt_mathml_text_engine.h"
 #include "qwt_mml_document.h"
+#include "qwt_text_metrics_cache.h"
 
 //! Constructor
 QwtMathMLTextEngine::QwtMathMLTextEngine()
@@ -53,20 +54,26 @@ QSizeF QwtMathMLTextEngine::textSize( const QFont &font,
 {
     Q_UNUSED( flags );
 
-    static QString t;
-    static QSizeF sz;
+    QwtTextMetricsCache *cache = QwtTextMetricsCache::instance();
 
-    if ( text != t )
+    // the document depends on the point size of the font only
+    QFont f;
+    f.setPointSizeF( font.pointSizeF() );
+
+    const QString key = QwtTextMetricsCache::key( "mathml", f, 0, text );
+
+    QSizeF size;
+    if ( !cache->find( key, size ) )
     {
         QwtMathMLDocument doc;
         doc.setContent( text );
         doc.setBaseFontPointSize( font.pointSizeF() );
 
-        sz = doc.size();
-        t = text;
+        size = doc.size();
+        cache->insert( key, size );
     }
 
-    return sz;
+    return size;
 }
 
 /*!